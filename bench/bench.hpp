@@ -0,0 +1,58 @@
+#ifndef CORE_BENCH_BENCH_HPP
+#define CORE_BENCH_BENCH_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+
+namespace bench {
+
+/* prevents the optimizer from discarding value, or from assuming memory is
+ * left unchanged across the call
+ */
+template <class T>
+inline void keep (T const& value) {
+#if defined(__GNUC__)
+  asm volatile("" : : "r,m"(value) : "memory");
+#else
+  auto volatile sink = &value;
+  (void)sink;
+#endif /* defined(__GNUC__) */
+}
+
+/* returns the mean time of one call to f in nanoseconds. The iteration count
+ * is doubled until a batch takes at least 100ms, and the fastest of three
+ * such batches is kept.
+ */
+template <class F>
+double measure (F&& f) {
+  using clock = std::chrono::steady_clock;
+  using nanoseconds = std::chrono::duration<double, std::nano>;
+  auto const minimum = nanoseconds { 1e8 };
+  auto batch = [&f] (std::size_t iterations) {
+    auto const start = clock::now();
+    for (std::size_t idx = 0; idx < iterations; ++idx) { f(); }
+    return nanoseconds { clock::now() - start };
+  };
+  std::size_t iterations = 1;
+  while (batch(iterations) < minimum) { iterations *= 2; }
+  auto best = batch(iterations);
+  for (auto run = 0; run < 2; ++run) {
+    auto const time = batch(iterations);
+    if (time < best) { best = time; }
+  }
+  return best.count() / iterations;
+}
+
+inline void report (char const* name, double ns) {
+  std::printf("%-48s %12.2f ns\n", name, ns);
+}
+
+/* also reports throughput, for a call that processes bytes bytes */
+inline void report (char const* name, double ns, std::size_t bytes) {
+  std::printf("%-48s %12.2f ns %9.2f GB/s\n", name, ns, bytes / ns);
+}
+
+} /* namespace bench */
+
+#endif /* CORE_BENCH_BENCH_HPP */
@@ -0,0 +1,44 @@
+#include <core/optional.hpp>
+
+#include <stdexcept>
+#include <vector>
+
+#include "bench.hpp"
+
+namespace {
+
+enum class parse_error { empty, invalid };
+
+/* every other input is invalid, as with a parser fed untrusted data */
+core::expected<int> parse_pointer (int input) {
+  if (input & 1) {
+    return std::make_exception_ptr(std::invalid_argument { "odd input" });
+  }
+  return input / 2;
+}
+
+core::expected<int, parse_error> parse_code (int input) {
+  if (input & 1) { return core::make_unexpected(parse_error::invalid); }
+  return input / 2;
+}
+
+template <class F>
+void run (char const* name, F parse) {
+  auto const ns = bench::measure([&parse] {
+    auto total = 0;
+    for (auto input = 0; input < 1024; ++input) {
+      auto const result = parse(input);
+      auto const copy = result;
+      if (copy) { total += *copy; }
+    }
+    bench::keep(total);
+  });
+  bench::report(name, ns / 1024);
+}
+
+} /* nameless namespace */
+
+int main () {
+  run("expected<int> (std::exception_ptr)", parse_pointer);
+  run("expected<int, parse_error>", parse_code);
+}
@@ -0,0 +1,77 @@
+#include <core/optional.hpp>
+
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+
+#include "bench.hpp"
+
+namespace {
+
+std::size_t allocations = 0;
+
+} /* nameless namespace */
+
+/* counts heap allocations, so that each copy of the payload is visible */
+void* operator new (std::size_t size) {
+  ++allocations;
+  if (auto ptr = std::malloc(size ? size : 1)) { return ptr; }
+  throw std::bad_alloc { };
+}
+
+void operator delete (void* ptr) noexcept { std::free(ptr); }
+void operator delete (void* ptr, std::size_t) noexcept { std::free(ptr); }
+
+namespace {
+
+using result = core::result<std::string>;
+
+/* both chains apply the same 5 edits, one through copies of the payload and
+ * the other by moving it from step to step
+ */
+auto const copying = [] (std::string const& str) {
+  auto copy = str;
+  ++copy.front();
+  return copy;
+};
+
+auto const moving = [] (std::string&& str) {
+  ++str.front();
+  return core::move(str);
+};
+
+template <class F>
+void run (char const* name, F&& chain) {
+  std::string const payload(4096, 'a');
+  auto const before = allocations;
+  chain(payload);
+  auto const count = allocations - before;
+  auto const ns = bench::measure([&chain, &payload] { chain(payload); });
+  char label[64];
+  std::snprintf(label, sizeof(label), "%s (%zu allocations)", name, count);
+  bench::report(label, ns);
+}
+
+} /* nameless namespace */
+
+int main () {
+  run("5 x map on lvalues", [] (std::string const& payload) {
+    result const value { payload };
+    auto const first = value.map(copying);
+    auto const second = first.map(copying);
+    auto const third = second.map(copying);
+    auto const fourth = third.map(copying);
+    auto const fifth = fourth.map(copying);
+    bench::keep(fifth->data());
+  });
+  run("5 x map on rvalues", [] (std::string const& payload) {
+    auto const fifth = result { payload }
+      .map(moving)
+      .map(moving)
+      .map(moving)
+      .map(moving)
+      .map(moving);
+    bench::keep(fifth->data());
+  });
+}
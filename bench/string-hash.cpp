@@ -0,0 +1,38 @@
+#include <core/string_view.hpp>
+
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "bench.hpp"
+
+namespace {
+
+template <class F>
+void run (char const* name, std::size_t size, F&& hash) {
+  char label[64];
+  std::snprintf(label, sizeof(label), "%s %zu bytes", name, size);
+  std::mt19937 engine { 5 };
+  std::vector<char> buffer(size);
+  for (auto& byte : buffer) { byte = static_cast<char>(engine()); }
+  auto const data = buffer.data();
+  auto const ns = bench::measure([&hash, data, size] {
+    bench::keep(data);
+    bench::keep(hash(data, size));
+  });
+  bench::report(label, ns, size);
+}
+
+} /* nameless namespace */
+
+int main () {
+  std::size_t const sizes[] = { 8, 16, 32, 64, 256, 4096, 1 << 20 };
+  for (auto size : sizes) {
+    run("wyhash", size, [] (char const* data, std::size_t len) {
+      return core::impl::wyhash { }(data, len, 0);
+    });
+    run("murmur<8>", size, [] (char const* data, std::size_t len) {
+      return core::impl::murmur<8> { }(data, len);
+    });
+  }
+}
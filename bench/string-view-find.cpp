@@ -0,0 +1,76 @@
+#include <core/string_view.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <string>
+
+#include "bench.hpp"
+
+namespace {
+
+/* the search string_view::find used before it was vectorized */
+std::size_t naive (core::string_view haystack, core::string_view needle) {
+  auto const iter = std::search(
+    haystack.begin(),
+    haystack.end(),
+    needle.begin(),
+    needle.end(),
+    std::char_traits<char>::eq);
+  return iter == haystack.end()
+    ? core::string_view::npos
+    : static_cast<std::size_t>(iter - haystack.begin());
+}
+
+/* throughput is measured over the bytes each search had to scan */
+void run (char const* label, std::string const& text, char const* str) {
+  core::string_view const haystack { text };
+  core::string_view const needle { str };
+  auto const first = haystack.find(needle);
+  auto const last = haystack.rfind(needle);
+  auto const forward = first == haystack.npos
+    ? haystack.size()
+    : first + needle.size();
+  auto const backward = last == haystack.npos
+    ? haystack.size()
+    : haystack.size() - last;
+  char name[96];
+  auto const simd = bench::measure([&] {
+    bench::keep(haystack.find(needle));
+  });
+  std::snprintf(name, sizeof(name), "%s find(\"%s\")", label, str);
+  bench::report(name, simd, forward);
+  auto const scalar = bench::measure([&] {
+    bench::keep(naive(haystack, needle));
+  });
+  std::snprintf(name, sizeof(name), "%s std::search(\"%s\")", label, str);
+  bench::report(name, scalar, forward);
+  auto const reverse = bench::measure([&] {
+    bench::keep(haystack.rfind(needle));
+  });
+  std::snprintf(name, sizeof(name), "%s rfind(\"%s\")", label, str);
+  bench::report(name, reverse, backward);
+}
+
+} /* nameless namespace */
+
+int main () {
+  std::string const line {
+    "2024-03-01T12:44:09.331Z host=api-7 pid=4412 level=info "
+    "route=/v1/orders latency_ms=12 status=200 bytes=5120 "
+    "user_agent=\"curl/8.4.0\" request_id=5b0c1a9e"
+  };
+  std::mt19937 engine { 3 };
+  std::string megabyte;
+  megabyte.reserve(1 << 20);
+  while (megabyte.size() < (1u << 20)) {
+    megabyte += static_cast<char>('a' + engine() % 26);
+  }
+  megabyte.replace(megabyte.size() / 2, 5, "ERROR");
+
+  run("log line", line, "=");
+  run("log line", line, "request_id");
+  run("log line", line, "level=error");
+  run("1 MiB", megabyte, "ERROR");
+  run("1 MiB", megabyte, "needle absent");
+}
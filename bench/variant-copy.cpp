@@ -0,0 +1,50 @@
+#include <core/variant.hpp>
+
+#include <string>
+#include <vector>
+
+#include "bench.hpp"
+
+namespace {
+
+/* the same values, in a variant whose std::string alternative keeps its
+ * copy constructor from being trivial
+ */
+using trivial = core::variant<int, double, char>;
+using nontrivial = core::variant<int, double, char, std::string>;
+
+template <class Variant>
+std::vector<Variant> make (std::size_t size) {
+  std::vector<Variant> values;
+  values.reserve(size);
+  for (std::size_t idx = 0; idx < size; ++idx) {
+    switch (idx % 3) {
+      case 0: values.emplace_back(static_cast<int>(idx)); break;
+      case 1: values.emplace_back(idx * 0.5); break;
+      default: values.emplace_back(static_cast<char>(idx)); break;
+    }
+  }
+  return values;
+}
+
+template <class Variant>
+void copy (char const* name, std::size_t size) {
+  auto const source = make<Variant>(size);
+  std::vector<Variant> target;
+  auto const ns = bench::measure([&] {
+    target = source;
+    bench::keep(target.data());
+  });
+  bench::report(name, ns, size * sizeof(Variant));
+}
+
+} /* nameless namespace */
+
+int main () {
+  static_assert(std::is_trivially_copyable<trivial>::value, "");
+  static_assert(not std::is_trivially_copyable<nontrivial>::value, "");
+  copy<trivial>("vector<variant<int, double, char>> 10k", 10000);
+  copy<nontrivial>("vector<variant<..., std::string>> 10k", 10000);
+  copy<trivial>("vector<variant<int, double, char>> 1M", 1000000);
+  copy<nontrivial>("vector<variant<..., std::string>> 1M", 1000000);
+}
@@ -0,0 +1,88 @@
+#include <core/variant.hpp>
+
+#include <random>
+#include <vector>
+
+#include "bench.hpp"
+
+namespace {
+
+using variant = core::variant<int, float, double, char>;
+
+/* a hand rolled variant with the same alternatives, so both visitation
+ * strategies can be driven with the same data and visitor
+ */
+struct tagged {
+  std::size_t tag;
+  union {
+    int i;
+    float f;
+    double d;
+    char c;
+  };
+};
+
+auto const visitor = core::impl::make_overload(
+  [] (int value) { return value * 2.0; },
+  [] (float value) { return value * 0.5; },
+  [] (double value) { return value + 1.0; },
+  [] (char value) { return static_cast<double>(value); }
+);
+
+using chain = core::impl::visit_chain<double, int, float, double, char>;
+using table = core::impl::visit_table<double, int, float, double, char>;
+
+template <class Strategy>
+double sum (std::vector<tagged>& values) {
+  auto total = 0.0;
+  for (auto& value : values) {
+    total += Strategy::call(
+      value.tag,
+      visitor,
+      static_cast<void*>(&value.i));
+  }
+  return total;
+}
+
+} /* nameless namespace */
+
+int main () {
+  std::mt19937 engine { 7 };
+  std::vector<variant> variants;
+  std::vector<tagged> values;
+  for (auto idx = 0; idx < 4096; ++idx) {
+    tagged value { };
+    value.tag = engine() % 4;
+    switch (value.tag) {
+      case 0: value.i = idx; variants.emplace_back(value.i); break;
+      case 1: value.f = idx * 0.25f; variants.emplace_back(value.f); break;
+      case 2: value.d = idx * 0.5; variants.emplace_back(value.d); break;
+      default:
+        value.c = static_cast<char>(idx);
+        variants.emplace_back(value.c);
+        break;
+    }
+    values.push_back(value);
+  }
+
+  auto const match = bench::measure([&variants] {
+    auto total = 0.0;
+    for (auto& value : variants) {
+      total += value.match(
+        [] (int value) { return value * 2.0; },
+        [] (float value) { return value * 0.5; },
+        [] (double value) { return value + 1.0; },
+        [] (char value) { return static_cast<double>(value); });
+    }
+    bench::keep(total);
+  });
+  auto const chained = bench::measure([&values] {
+    bench::keep(sum<chain>(values));
+  });
+  auto const tabled = bench::measure([&values] {
+    bench::keep(sum<table>(values));
+  });
+  bench::report("variant<int, float, double, char>::match", match / 4096);
+  bench::report("visit_chain (if-chain)", chained / 4096);
+  bench::report("visit_table (function pointers)", tabled / 4096);
+}
@@ -621,6 +621,15 @@ auto search (Range1&& rng1, Range2&& rng2, BinaryPred&& bp) -> enable_if_t<
   );
 }
 
+template <class Range, class Searcher>
+auto search (Range&& rng, Searcher const& searcher) -> enable_if_t<
+  is_range<Range>::value and not is_range<Searcher>::value,
+  decltype(::std::begin(::core::forward<Range>(rng)))
+> {
+  auto range = make_range(::core::forward<Range>(rng));
+  return searcher(::std::begin(range), ::std::end(range)).first;
+}
+
 template <class Range, class Size, class T>
 auto search_n (Range&& rng, Size&& count, T const& value) -> enable_if_t<
   is_range<Range>::value,
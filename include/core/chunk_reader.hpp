@@ -0,0 +1,295 @@
+#ifndef CORE_CHUNK_READER_HPP
+#define CORE_CHUNK_READER_HPP
+
+#include <system_error>
+#include <streambuf>
+#include <iterator>
+#include <istream>
+#include <memory>
+
+#include <climits>
+#include <cerrno>
+
+#include <core/string_view.hpp>
+#include <core/optional.hpp>
+#include <core/range.hpp>
+
+#if defined(_WIN32)
+  #include <io.h>
+#else
+  #include <unistd.h>
+#endif /* defined(_WIN32) */
+
+namespace core {
+inline namespace v2 {
+
+template <class CharT, class Traits> struct basic_chunk_reader;
+
+/* input iterators over a basic_chunk_reader. The view they refer to is only
+ * valid until they are incremented.
+ */
+template <class CharT, class Traits=::std::char_traits<CharT>>
+struct chunk_iterator final {
+  using iterator_category = ::std::input_iterator_tag;
+  using value_type = basic_string_view<CharT, Traits>;
+  using difference_type = ::std::ptrdiff_t;
+  using reference = value_type const&;
+  using pointer = value_type const*;
+
+  explicit chunk_iterator (basic_chunk_reader<CharT, Traits>& reader) :
+    reader { ::std::addressof(reader) }
+  { ++*this; }
+
+  chunk_iterator () noexcept = default;
+
+  reference operator * () const noexcept { return this->chunk; }
+  pointer operator -> () const noexcept { return &this->chunk; }
+
+  chunk_iterator& operator ++ () {
+    this->chunk = this->reader->next_chunk();
+    if (this->chunk.empty()) { this->reader = nullptr; }
+    return *this;
+  }
+
+  void operator ++ (int) { ++*this; }
+
+  bool operator == (chunk_iterator const& that) const noexcept {
+    return this->reader == that.reader;
+  }
+
+  bool operator != (chunk_iterator const& that) const noexcept {
+    return this->reader != that.reader;
+  }
+
+private:
+  basic_chunk_reader<CharT, Traits>* reader { nullptr };
+  value_type chunk { };
+};
+
+template <class CharT, class Traits=::std::char_traits<CharT>>
+struct line_iterator final {
+  using iterator_category = ::std::input_iterator_tag;
+  using value_type = basic_string_view<CharT, Traits>;
+  using difference_type = ::std::ptrdiff_t;
+  using reference = value_type const&;
+  using pointer = value_type const*;
+
+  explicit line_iterator (basic_chunk_reader<CharT, Traits>& reader) :
+    reader { ::std::addressof(reader) }
+  { ++*this; }
+
+  line_iterator () noexcept = default;
+
+  reference operator * () const noexcept { return this->line; }
+  pointer operator -> () const noexcept { return &this->line; }
+
+  line_iterator& operator ++ () {
+    if (not this->reader->next_line(this->line)) { this->reader = nullptr; }
+    return *this;
+  }
+
+  void operator ++ (int) { ++*this; }
+
+  bool operator == (line_iterator const& that) const noexcept {
+    return this->reader == that.reader;
+  }
+
+  bool operator != (line_iterator const& that) const noexcept {
+    return this->reader != that.reader;
+  }
+
+private:
+  basic_chunk_reader<CharT, Traits>* reader { nullptr };
+  value_type line { };
+};
+
+/* reads a stream buffer or file descriptor in large blocks, and hands out
+ * views into its own buffer. Unlike istreambuf_iterator, there is one virtual
+ * call (or system call) per block rather than per character, and scanning for
+ * line breaks is done with Traits::find over the whole block.
+ *
+ * Every view returned is invalidated by the next read from the reader.
+ */
+template <class CharT, class Traits=::std::char_traits<CharT>>
+struct basic_chunk_reader final {
+  using streambuf_type = ::std::basic_streambuf<CharT, Traits>;
+  using istream_type = ::std::basic_istream<CharT, Traits>;
+  using view_type = basic_string_view<CharT, Traits>;
+  using traits_type = Traits;
+  using value_type = CharT;
+  using size_type = ::std::size_t;
+
+  enum : size_type { default_size = 65536 };
+
+  explicit basic_chunk_reader (
+    streambuf_type* buffer,
+    size_type size=default_size
+  ) :
+    source { buffer },
+    descriptor { -1 },
+    capacity { size ? size : size_type { 1 } },
+    storage { new value_type[this->capacity] }
+  { }
+
+  /* reads directly from the stream's buffer, bypassing its sentry. The
+   * stream's state is not updated.
+   */
+  explicit basic_chunk_reader (
+    istream_type& stream,
+    size_type size=default_size
+  ) : basic_chunk_reader { stream.rdbuf(), size } { }
+
+  /* reads with read(2), which requires a byte sized character type. The
+   * descriptor is not closed by the reader.
+   */
+  explicit basic_chunk_reader (int fd, size_type size=default_size) :
+    source { nullptr },
+    descriptor { fd },
+    capacity { size ? size : size_type { 1 } },
+    storage { new value_type[this->capacity] }
+  {
+    static_assert(
+      sizeof(CharT) == 1,
+      "file descriptors can only be read into byte sized characters"
+    );
+  }
+
+  basic_chunk_reader (basic_chunk_reader const&) = delete;
+  basic_chunk_reader (basic_chunk_reader&&) = default;
+  basic_chunk_reader& operator = (basic_chunk_reader const&) = delete;
+  basic_chunk_reader& operator = (basic_chunk_reader&&) = default;
+
+  /* returns anything left in the buffer from a previous call to next_line,
+   * otherwise up to one buffer's worth of newly read characters. An empty
+   * view means the end of the input was reached.
+   */
+  view_type next_chunk () {
+    if (this->head == this->tail) {
+      this->head = 0;
+      this->tail = this->read(this->storage.get(), this->capacity);
+      this->scanned = 0;
+      this->exhausted = not this->tail;
+    }
+    view_type chunk {
+      this->storage.get() + this->head,
+      this->tail - this->head
+    };
+    this->head = this->tail;
+    return chunk;
+  }
+
+  /* stores the next line in line, without its line feed, and returns false
+   * once the input is exhausted. A final line without a line feed is still
+   * returned. The buffer is grown when a line does not fit in it.
+   */
+  bool next_line (view_type& line) {
+    auto const delimiter = static_cast<value_type>('\n');
+    while (true) {
+      auto const data = this->storage.get();
+      auto const start = data + ::std::max(this->head, this->scanned);
+      auto const found = Traits::find(
+        start,
+        static_cast<size_type>(data + this->tail - start),
+        delimiter
+      );
+      if (found) {
+        auto const end = static_cast<size_type>(found - data);
+        line = view_type { data + this->head, end - this->head };
+        this->head = end + 1;
+        return true;
+      }
+      this->scanned = this->tail;
+      if (this->exhausted) {
+        if (this->head == this->tail) { return false; }
+        line = view_type { data + this->head, this->tail - this->head };
+        this->head = this->tail;
+        return true;
+      }
+      this->refill();
+    }
+  }
+
+  range<chunk_iterator<CharT, Traits>> chunks () {
+    using iterator = chunk_iterator<CharT, Traits>;
+    return make_range(iterator { *this }, iterator { });
+  }
+
+  range<line_iterator<CharT, Traits>> lines () {
+    using iterator = line_iterator<CharT, Traits>;
+    return make_range(iterator { *this }, iterator { });
+  }
+
+  size_type buffer_size () const noexcept { return this->capacity; }
+
+private:
+  /* moves the unread characters to the front of the buffer, growing it if
+   * they already fill it, and reads as much as fits after them
+   */
+  void refill () {
+    auto const pending = this->tail - this->head;
+    auto const scanned = this->scanned - this->head;
+    if (pending == this->capacity) {
+      ::std::unique_ptr<value_type[]> grown {
+        new value_type[this->capacity * 2]
+      };
+      Traits::copy(grown.get(), this->storage.get() + this->head, pending);
+      this->storage = ::core::move(grown);
+      this->capacity *= 2;
+    } else if (this->head) {
+      auto const data = this->storage.get();
+      Traits::move(data, data + this->head, pending);
+    }
+    this->head = 0;
+    this->scanned = scanned;
+    this->tail = pending;
+    auto const count = this->read(
+      this->storage.get() + pending,
+      this->capacity - pending
+    );
+    this->tail += count;
+    this->exhausted = not count;
+  }
+
+  size_type read (value_type* buffer, size_type count) {
+    if (this->source) {
+      return static_cast<size_type>(
+        this->source->sgetn(buffer, static_cast<::std::streamsize>(count))
+      );
+    }
+    while (true) {
+#if defined(_WIN32)
+      auto const result = ::_read(
+        this->descriptor,
+        buffer,
+        static_cast<unsigned>(::std::min<size_type>(count, INT_MAX))
+      );
+#else
+      auto const result = ::read(this->descriptor, buffer, count);
+#endif /* defined(_WIN32) */
+      if (result >= 0) { return static_cast<size_type>(result); }
+      if (errno != EINTR) {
+        throw_system_error(
+          ::std::error_condition { errno, ::std::system_category() }
+        );
+      }
+    }
+  }
+
+  streambuf_type* source;
+  int descriptor;
+  size_type capacity;
+  ::std::unique_ptr<value_type[]> storage;
+  size_type head { 0 };
+  size_type tail { 0 };
+  size_type scanned { 0 };
+  bool exhausted { false };
+};
+
+using chunk_reader = basic_chunk_reader<char>;
+using wchunk_reader = basic_chunk_reader<wchar_t>;
+using u16chunk_reader = basic_chunk_reader<char16_t>;
+using u32chunk_reader = basic_chunk_reader<char32_t>;
+
+}} /* namespace core::v2 */
+
+#endif /* CORE_CHUNK_READER_HPP */
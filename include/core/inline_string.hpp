@@ -0,0 +1,688 @@
+#ifndef CORE_INLINE_STRING_HPP
+#define CORE_INLINE_STRING_HPP
+
+#include <core/memory_resource.hpp>
+#include <core/string_view.hpp>
+#include <core/type_traits.hpp>
+
+#include <functional>
+#include <stdexcept>
+#include <iterator>
+#include <ostream>
+#include <limits>
+#include <string>
+
+#include <cstdint>
+#include <cstring>
+
+namespace core {
+inline namespace v2 {
+
+#ifndef CORE_NO_EXCEPTIONS
+[[noreturn]] inline void throw_length_error (char const* msg) {
+  throw ::std::length_error { msg };
+}
+#else /* CORE_NO_EXCEPTIONS */
+[[noreturn]] inline void throw_length_error (char const*) { ::std::abort(); }
+#endif /* CORE_NO_EXCEPTIONS */
+
+namespace impl {
+
+/* the smallest unsigned type able to hold every size up to N */
+template <::std::size_t N>
+using inline_size_t = conditional_t<
+  N <= UINT8_MAX,
+  ::std::uint8_t,
+  conditional_t<
+    N <= UINT16_MAX,
+    ::std::uint16_t,
+    conditional_t<N <= UINT32_MAX, ::std::uint32_t, ::std::size_t>
+  >
+>;
+
+/* used when an inline string spills to an allocator. The characters live in
+ * the buffer until the capacity exceeds N, at which point the same bytes hold
+ * a pointer to the allocation instead. Nothing refers back into the object
+ * itself, so it may be relocated with memcpy.
+ */
+template <class CharT, ::std::size_t N, class Allocator>
+struct inline_storage final {
+  static_assert(
+    ::std::is_same<Allocator, pmr::polymorphic_allocator<CharT>>::value,
+    "inline strings can only spill to a polymorphic_allocator"
+  );
+
+  using allocator_type = Allocator;
+  using size_type = ::std::size_t;
+
+  explicit inline_storage (
+    allocator_type const& allocator=allocator_type { }
+  ) noexcept : allocator { allocator } { this->contents.buffer[0] = CharT { }; }
+
+  inline_storage (inline_storage const& that) :
+    inline_storage { that.allocator.select_on_container_copy_construction() }
+  { this->copy(that); }
+
+  inline_storage (inline_storage&& that) noexcept :
+    allocator { that.allocator }
+  { this->steal(that); }
+
+  ~inline_storage () noexcept { this->release(); }
+
+  inline_storage& operator = (inline_storage const& that) {
+    if (this != &that) { this->copy(that); }
+    return *this;
+  }
+
+  /* polymorphic allocators do not propagate, so memory can only be taken
+   * from that when both use the same resource
+   */
+  inline_storage& operator = (inline_storage&& that) {
+    if (this == &that) { return *this; }
+    if (this->allocator != that.allocator) { this->copy(that); }
+    else {
+      this->release();
+      this->steal(that);
+    }
+    return *this;
+  }
+
+  void swap (inline_storage& that) {
+    if (this->allocator == that.allocator) {
+      inline_storage temp { this->allocator };
+      temp.steal(*this);
+      this->steal(that);
+      that.steal(temp);
+      return;
+    }
+    inline_storage temp { this->allocator };
+    temp.copy(*this);
+    this->copy(that);
+    that.copy(temp);
+  }
+
+  allocator_type get_allocator () const noexcept { return this->allocator; }
+
+  CharT const* data () const noexcept {
+    return this->spilled() ? this->contents.pointer : this->contents.buffer;
+  }
+
+  CharT* data () noexcept {
+    return this->spilled() ? this->contents.pointer : this->contents.buffer;
+  }
+
+  size_type size () const noexcept { return this->length; }
+  size_type capacity () const noexcept { return this->limit; }
+
+  size_type max_size () const noexcept {
+    return ::std::numeric_limits<size_type>::max() / sizeof(CharT) - 1;
+  }
+
+  void set_size (size_type size) noexcept {
+    this->length = size;
+    this->data()[size] = CharT { };
+  }
+
+  /* returns the (possibly moved) characters, with room for at least size of
+   * them. Growth is geometric so that repeated appends are amortized.
+   */
+  CharT* reserve (size_type size) {
+    if (size <= this->limit) { return this->data(); }
+    if (size > this->max_size()) {
+      throw_length_error("inline string exceeds max_size");
+    }
+    auto const capacity = ::std::max(size, this->limit * 2);
+    auto const memory = this->allocator.allocate(capacity + 1);
+    ::std::memcpy(memory, this->data(), (this->length + 1) * sizeof(CharT));
+    this->release();
+    this->contents.pointer = memory;
+    this->limit = capacity;
+    return memory;
+  }
+
+  void shrink_to_fit () {
+    if (not this->spilled() or this->length == this->limit) { return; }
+    if (this->length > N) {
+      auto const memory = this->allocator.allocate(this->length + 1);
+      auto const bytes = (this->length + 1) * sizeof(CharT);
+      ::std::memcpy(memory, this->contents.pointer, bytes);
+      this->release();
+      this->contents.pointer = memory;
+      this->limit = this->length;
+      return;
+    }
+    auto const memory = this->contents.pointer;
+    auto const capacity = this->limit;
+    auto const bytes = (this->length + 1) * sizeof(CharT);
+    ::std::memcpy(this->contents.buffer, memory, bytes);
+    this->limit = N;
+    this->allocator.deallocate(memory, capacity + 1);
+  }
+
+private:
+  bool spilled () const noexcept { return this->limit > N; }
+
+  void release () noexcept {
+    if (not this->spilled()) { return; }
+    this->allocator.deallocate(this->contents.pointer, this->limit + 1);
+    this->limit = N;
+  }
+
+  void copy (inline_storage const& that) {
+    auto const memory = this->reserve(that.length);
+    ::std::memcpy(memory, that.data(), (that.length + 1) * sizeof(CharT));
+    this->length = that.length;
+  }
+
+  /* requires that this holds no allocation */
+  void steal (inline_storage& that) noexcept {
+    ::std::memcpy(&this->contents, &that.contents, sizeof(this->contents));
+    this->length = that.length;
+    this->limit = that.limit;
+    that.length = 0;
+    that.limit = N;
+    that.contents.buffer[0] = CharT { };
+  }
+
+  /* copied as a whole: for small N the pointer is wider than the buffer */
+  union {
+    CharT buffer[N + 1];
+    CharT* pointer;
+  } contents;
+  size_type length { 0 };
+  size_type limit { N };
+  allocator_type allocator;
+};
+
+/* when an inline string cannot spill, its storage is trivially copyable */
+template <class CharT, ::std::size_t N>
+struct inline_storage<CharT, N, void> final {
+  using size_type = ::std::size_t;
+
+  CharT const* data () const noexcept { return this->buffer; }
+  CharT* data () noexcept { return this->buffer; }
+
+  size_type size () const noexcept { return this->length; }
+  constexpr size_type capacity () const noexcept { return N; }
+  constexpr size_type max_size () const noexcept { return N; }
+
+  void set_size (size_type size) noexcept {
+    this->length = static_cast<inline_size_t<N>>(size);
+    this->buffer[size] = CharT { };
+  }
+
+  CharT* reserve (size_type size) {
+    if (size > N) { throw_length_error("inline string capacity exceeded"); }
+    return this->buffer;
+  }
+
+  void shrink_to_fit () noexcept { }
+
+  void swap (inline_storage& that) noexcept {
+    auto const temp = *this;
+    *this = that;
+    that = temp;
+  }
+
+  CharT buffer[N + 1] { };
+  inline_size_t<N> length { 0 };
+};
+
+} /* namespace impl */
+
+/* a string whose first N characters are stored within the object itself.
+ * When Allocator is void, the capacity is fixed at N and exceeding it throws
+ * std::length_error; the type is then trivially copyable. When Allocator is a
+ * pmr::polymorphic_allocator, longer strings are moved to memory obtained
+ * from it instead. In both cases the object holds no pointers into itself,
+ * so it is trivially relocatable.
+ */
+template <
+  class CharT,
+  ::std::size_t N,
+  class Traits=::std::char_traits<CharT>,
+  class Allocator=void
+> struct basic_inline_string {
+  static_assert(N > 0, "inline strings must have a capacity");
+
+  using view_type = basic_string_view<CharT, Traits>;
+  using traits_type = Traits;
+  using allocator_type = Allocator;
+
+  using difference_type = ::std::ptrdiff_t;
+  using value_type = CharT;
+  using size_type = ::std::size_t;
+
+  using reference = value_type&;
+  using const_reference = value_type const&;
+  using pointer = value_type*;
+  using const_pointer = value_type const*;
+
+  using iterator = pointer;
+  using const_iterator = const_pointer;
+  using reverse_iterator = ::std::reverse_iterator<iterator>;
+  using const_reverse_iterator = ::std::reverse_iterator<const_iterator>;
+
+  static constexpr size_type npos = view_type::npos;
+  static constexpr size_type inline_capacity = N;
+
+  basic_inline_string () = default;
+
+  basic_inline_string (view_type str) { this->assign(str); }
+
+  basic_inline_string (const_pointer str) :
+    basic_inline_string { view_type { str } }
+  { }
+
+  basic_inline_string (const_pointer str, size_type count) :
+    basic_inline_string { view_type { str, count } }
+  { }
+
+  basic_inline_string (size_type count, value_type ch) {
+    this->assign(count, ch);
+  }
+
+  template <class A>
+  explicit basic_inline_string (
+    ::std::basic_string<CharT, Traits, A> const& str
+  ) : basic_inline_string { view_type { str } } { }
+
+  template <class A=Allocator>
+  explicit basic_inline_string (
+    enable_if_t<not ::std::is_void<A>::value, A> const& allocator
+  ) noexcept : storage { allocator } { }
+
+  template <class A=Allocator>
+  basic_inline_string (
+    view_type str,
+    enable_if_t<not ::std::is_void<A>::value, A> const& allocator
+  ) : storage { allocator } { this->assign(str); }
+
+  basic_inline_string& operator = (view_type str) { return this->assign(str); }
+
+  basic_inline_string& operator = (const_pointer str) {
+    return this->assign(view_type { str });
+  }
+
+  basic_inline_string& operator += (view_type str) {
+    return this->append(str);
+  }
+
+  basic_inline_string& operator += (const_pointer str) {
+    return this->append(view_type { str });
+  }
+
+  basic_inline_string& operator += (value_type ch) {
+    return this->append(1, ch);
+  }
+
+  operator view_type () const noexcept { return this->view(); }
+
+  template <class A=Allocator>
+  auto get_allocator () const noexcept -> enable_if_t<
+    not ::std::is_void<A>::value,
+    A
+  > {
+    return this->storage.get_allocator();
+  }
+
+  view_type view () const noexcept {
+    return view_type { this->data(), this->size() };
+  }
+
+  template <class A=::std::allocator<CharT>>
+  ::std::basic_string<CharT, Traits, A> to_string (
+    A const& allocator=A()
+  ) const {
+    return this->view().to_string(allocator);
+  }
+
+  const_reference operator [] (size_type idx) const noexcept {
+    return this->data()[idx];
+  }
+
+  reference operator [] (size_type idx) noexcept { return this->data()[idx]; }
+
+  const_reference at (size_type idx) const {
+    if (idx >= this->size()) {
+      throw_out_of_range("requested index out of range");
+    }
+    return this->data()[idx];
+  }
+
+  reference at (size_type idx) {
+    if (idx >= this->size()) {
+      throw_out_of_range("requested index out of range");
+    }
+    return this->data()[idx];
+  }
+
+  const_reference front () const noexcept { return this->data()[0]; }
+  reference front () noexcept { return this->data()[0]; }
+
+  const_reference back () const noexcept {
+    return this->data()[this->size() - 1];
+  }
+
+  reference back () noexcept { return this->data()[this->size() - 1]; }
+
+  const_pointer c_str () const noexcept { return this->data(); }
+  const_pointer data () const noexcept { return this->storage.data(); }
+  pointer data () noexcept { return this->storage.data(); }
+
+  const_iterator cbegin () const noexcept { return this->data(); }
+  const_iterator cend () const noexcept { return this->data() + this->size(); }
+
+  const_iterator begin () const noexcept { return this->cbegin(); }
+  const_iterator end () const noexcept { return this->cend(); }
+
+  iterator begin () noexcept { return this->data(); }
+  iterator end () noexcept { return this->data() + this->size(); }
+
+  const_reverse_iterator crbegin () const noexcept {
+    return const_reverse_iterator { this->cend() };
+  }
+
+  const_reverse_iterator crend () const noexcept {
+    return const_reverse_iterator { this->cbegin() };
+  }
+
+  const_reverse_iterator rbegin () const noexcept { return this->crbegin(); }
+  const_reverse_iterator rend () const noexcept { return this->crend(); }
+
+  reverse_iterator rbegin () noexcept {
+    return reverse_iterator { this->end() };
+  }
+
+  reverse_iterator rend () noexcept {
+    return reverse_iterator { this->begin() };
+  }
+
+  size_type max_size () const noexcept { return this->storage.max_size(); }
+  size_type capacity () const noexcept { return this->storage.capacity(); }
+  size_type length () const noexcept { return this->size(); }
+  size_type size () const noexcept { return this->storage.size(); }
+  bool empty () const noexcept { return not this->size(); }
+
+  /* throws std::length_error if size exceeds max_size() */
+  void reserve (size_type size) { this->storage.reserve(size); }
+
+  /* moves a spilled string back into the object when it fits */
+  void shrink_to_fit () { this->storage.shrink_to_fit(); }
+
+  void clear () noexcept { this->storage.set_size(0); }
+
+  basic_inline_string& assign (view_type str) {
+    auto const data = this->storage.reserve(str.size());
+    Traits::move(data, str.data(), str.size());
+    this->storage.set_size(str.size());
+    return *this;
+  }
+
+  basic_inline_string& assign (size_type count, value_type ch) {
+    Traits::assign(this->storage.reserve(count), count, ch);
+    this->storage.set_size(count);
+    return *this;
+  }
+
+  /* str may refer to this string's own characters */
+  basic_inline_string& append (view_type str) {
+    ::std::less<const_pointer> const less { };
+    auto const size = this->size();
+    auto const first = this->data();
+    auto const inside = not less(str.data(), first)
+      and less(str.data(), first + size);
+    auto const offset = inside ? str.data() - first : 0;
+    auto const data = this->storage.reserve(size + str.size());
+    auto const source = inside ? data + offset : str.data();
+    Traits::copy(data + size, source, str.size());
+    this->storage.set_size(size + str.size());
+    return *this;
+  }
+
+  basic_inline_string& append (size_type count, value_type ch) {
+    auto const size = this->size();
+    Traits::assign(this->storage.reserve(size + count) + size, count, ch);
+    this->storage.set_size(size + count);
+    return *this;
+  }
+
+  void push_back (value_type ch) { this->append(1, ch); }
+  void pop_back () noexcept { this->storage.set_size(this->size() - 1); }
+
+  basic_inline_string& erase (size_type pos=0, size_type count=npos) {
+    auto const size = this->size();
+    if (pos > size) { throw_out_of_range("start position out of range"); }
+    count = ::std::min(count, size - pos);
+    auto const data = this->data();
+    Traits::move(data + pos, data + pos + count, size - pos - count);
+    this->storage.set_size(size - count);
+    return *this;
+  }
+
+  void resize (size_type count, value_type ch=value_type { }) {
+    auto const size = this->size();
+    if (count > size) {
+      Traits::assign(this->storage.reserve(count) + size, count - size, ch);
+    }
+    this->storage.set_size(count);
+  }
+
+  int compare (view_type that) const noexcept {
+    return this->view().compare(that);
+  }
+
+  void swap (basic_inline_string& that) { this->storage.swap(that.storage); }
+
+private:
+  impl::inline_storage<CharT, N, Allocator> storage;
+};
+
+template <class CharT, ::std::size_t N, class Traits, class Allocator>
+constexpr typename basic_inline_string<CharT, N, Traits, Allocator>::size_type
+basic_inline_string<CharT, N, Traits, Allocator>::npos;
+
+template <class CharT, ::std::size_t N, class Traits, class Allocator>
+constexpr typename basic_inline_string<CharT, N, Traits, Allocator>::size_type
+basic_inline_string<CharT, N, Traits, Allocator>::inline_capacity;
+
+template <::std::size_t N>
+using u32inline_string = basic_inline_string<char32_t, N>;
+template <::std::size_t N>
+using u16inline_string = basic_inline_string<char16_t, N>;
+template <::std::size_t N>
+using winline_string = basic_inline_string<wchar_t, N>;
+template <::std::size_t N>
+using inline_string = basic_inline_string<char, N>;
+
+/* inline_string comparison inline_string */
+template <
+  class CharT, class Traits,
+  ::std::size_t N, class A,
+  ::std::size_t M, class B
+> bool operator == (
+  basic_inline_string<CharT, N, Traits, A> const& lhs,
+  basic_inline_string<CharT, M, Traits, B> const& rhs
+) noexcept { return lhs.view() == rhs.view(); }
+
+template <
+  class CharT, class Traits,
+  ::std::size_t N, class A,
+  ::std::size_t M, class B
+> bool operator != (
+  basic_inline_string<CharT, N, Traits, A> const& lhs,
+  basic_inline_string<CharT, M, Traits, B> const& rhs
+) noexcept { return lhs.view() != rhs.view(); }
+
+template <
+  class CharT, class Traits,
+  ::std::size_t N, class A,
+  ::std::size_t M, class B
+> bool operator >= (
+  basic_inline_string<CharT, N, Traits, A> const& lhs,
+  basic_inline_string<CharT, M, Traits, B> const& rhs
+) noexcept { return lhs.view() >= rhs.view(); }
+
+template <
+  class CharT, class Traits,
+  ::std::size_t N, class A,
+  ::std::size_t M, class B
+> bool operator <= (
+  basic_inline_string<CharT, N, Traits, A> const& lhs,
+  basic_inline_string<CharT, M, Traits, B> const& rhs
+) noexcept { return lhs.view() <= rhs.view(); }
+
+template <
+  class CharT, class Traits,
+  ::std::size_t N, class A,
+  ::std::size_t M, class B
+> bool operator > (
+  basic_inline_string<CharT, N, Traits, A> const& lhs,
+  basic_inline_string<CharT, M, Traits, B> const& rhs
+) noexcept { return lhs.view() > rhs.view(); }
+
+template <
+  class CharT, class Traits,
+  ::std::size_t N, class A,
+  ::std::size_t M, class B
+> bool operator < (
+  basic_inline_string<CharT, N, Traits, A> const& lhs,
+  basic_inline_string<CharT, M, Traits, B> const& rhs
+) noexcept { return lhs.view() < rhs.view(); }
+
+/* inline_string comparison string_view. The view is not deduced, so that
+ * string literals and std::basic_string compare as well.
+ */
+template <class CharT, ::std::size_t N, class Traits, class A>
+bool operator == (
+  basic_inline_string<CharT, N, Traits, A> const& lhs,
+  identity_t<basic_string_view<CharT, Traits>> rhs
+) noexcept { return lhs.view() == rhs; }
+
+template <class CharT, ::std::size_t N, class Traits, class A>
+bool operator != (
+  basic_inline_string<CharT, N, Traits, A> const& lhs,
+  identity_t<basic_string_view<CharT, Traits>> rhs
+) noexcept { return lhs.view() != rhs; }
+
+template <class CharT, ::std::size_t N, class Traits, class A>
+bool operator >= (
+  basic_inline_string<CharT, N, Traits, A> const& lhs,
+  identity_t<basic_string_view<CharT, Traits>> rhs
+) noexcept { return lhs.view() >= rhs; }
+
+template <class CharT, ::std::size_t N, class Traits, class A>
+bool operator <= (
+  basic_inline_string<CharT, N, Traits, A> const& lhs,
+  identity_t<basic_string_view<CharT, Traits>> rhs
+) noexcept { return lhs.view() <= rhs; }
+
+template <class CharT, ::std::size_t N, class Traits, class A>
+bool operator > (
+  basic_inline_string<CharT, N, Traits, A> const& lhs,
+  identity_t<basic_string_view<CharT, Traits>> rhs
+) noexcept { return lhs.view() > rhs; }
+
+template <class CharT, ::std::size_t N, class Traits, class A>
+bool operator < (
+  basic_inline_string<CharT, N, Traits, A> const& lhs,
+  identity_t<basic_string_view<CharT, Traits>> rhs
+) noexcept { return lhs.view() < rhs; }
+
+/* string_view comparison inline_string */
+template <class CharT, ::std::size_t N, class Traits, class A>
+bool operator == (
+  identity_t<basic_string_view<CharT, Traits>> lhs,
+  basic_inline_string<CharT, N, Traits, A> const& rhs
+) noexcept { return lhs == rhs.view(); }
+
+template <class CharT, ::std::size_t N, class Traits, class A>
+bool operator != (
+  identity_t<basic_string_view<CharT, Traits>> lhs,
+  basic_inline_string<CharT, N, Traits, A> const& rhs
+) noexcept { return lhs != rhs.view(); }
+
+template <class CharT, ::std::size_t N, class Traits, class A>
+bool operator >= (
+  identity_t<basic_string_view<CharT, Traits>> lhs,
+  basic_inline_string<CharT, N, Traits, A> const& rhs
+) noexcept { return lhs >= rhs.view(); }
+
+template <class CharT, ::std::size_t N, class Traits, class A>
+bool operator <= (
+  identity_t<basic_string_view<CharT, Traits>> lhs,
+  basic_inline_string<CharT, N, Traits, A> const& rhs
+) noexcept { return lhs <= rhs.view(); }
+
+template <class CharT, ::std::size_t N, class Traits, class A>
+bool operator > (
+  identity_t<basic_string_view<CharT, Traits>> lhs,
+  basic_inline_string<CharT, N, Traits, A> const& rhs
+) noexcept { return lhs > rhs.view(); }
+
+template <class CharT, ::std::size_t N, class Traits, class A>
+bool operator < (
+  identity_t<basic_string_view<CharT, Traits>> lhs,
+  basic_inline_string<CharT, N, Traits, A> const& rhs
+) noexcept { return lhs < rhs.view(); }
+
+template <class CharT, ::std::size_t N, class Traits, class A>
+::std::basic_ostream<CharT, Traits>& operator << (
+  ::std::basic_ostream<CharT, Traits>& os,
+  basic_inline_string<CharT, N, Traits, A> const& str
+) { return os << str.view(); }
+
+template <class CharT, ::std::size_t N, class Traits, class A>
+void swap (
+  basic_inline_string<CharT, N, Traits, A>& lhs,
+  basic_inline_string<CharT, N, Traits, A>& rhs
+) { lhs.swap(rhs); }
+
+}} /* namespace core::v2 */
+
+namespace core {
+inline namespace v2 {
+namespace pmr {
+
+template <
+  class CharT,
+  ::std::size_t N,
+  class Traits = ::std::char_traits<CharT>
+> using basic_inline_string = ::core::v2::basic_inline_string<
+  CharT,
+  N,
+  Traits,
+  polymorphic_allocator<CharT>
+>;
+
+template <::std::size_t N>
+using u32inline_string = basic_inline_string<char32_t, N>;
+template <::std::size_t N>
+using u16inline_string = basic_inline_string<char16_t, N>;
+template <::std::size_t N>
+using winline_string = basic_inline_string<wchar_t, N>;
+template <::std::size_t N>
+using inline_string = basic_inline_string<char, N>;
+
+}}} /* namespace core::v2::pmr */
+
+namespace std {
+
+template <class CharT, size_t N, class Traits, class Allocator>
+struct hash<core::v2::basic_inline_string<CharT, N, Traits, Allocator>> {
+  using argument_type = core::v2::basic_inline_string<
+    CharT,
+    N,
+    Traits,
+    Allocator
+  >;
+  using result_type = size_t;
+
+  result_type operator ()(argument_type const& str) const noexcept {
+    return hash<core::v2::basic_string_view<CharT, Traits>> { }(str.view());
+  }
+};
+
+} /* namespace std */
+
+#endif /* CORE_INLINE_STRING_HPP */
@@ -0,0 +1,261 @@
+#ifndef CORE_INTERN_HPP
+#define CORE_INTERN_HPP
+
+#include <core/memory_resource.hpp>
+#include <core/string_view.hpp>
+
+#include <functional>
+#include <vector>
+
+#include <cstdint>
+#include <cstring>
+
+namespace core {
+inline namespace v2 {
+namespace impl {
+
+/* lives in the pool's arena, immediately followed by the (null terminated)
+ * characters it refers to.
+ */
+template <class CharT, class Traits>
+struct symbol_entry final {
+  basic_string_view<CharT, Traits> view;
+  ::std::uint64_t hash;
+  ::std::size_t id;
+};
+
+} /* namespace impl */
+
+template <class CharT, class Traits> struct basic_intern_pool;
+
+/* a handle to a string interned by a basic_intern_pool. Two symbols from the
+ * same pool are equal exactly when their strings are equal, so comparison and
+ * hashing never look at the characters.
+ */
+template <class CharT, class Traits=::std::char_traits<CharT>>
+struct basic_symbol final {
+  using view_type = basic_string_view<CharT, Traits>;
+  using traits_type = Traits;
+  using value_type = CharT;
+  using size_type = ::std::size_t;
+
+  constexpr basic_symbol () noexcept = default;
+
+  explicit operator bool () const noexcept { return this->entry; }
+  operator view_type () const noexcept { return this->view(); }
+
+  view_type view () const noexcept {
+    return this->entry ? this->entry->view : view_type { };
+  }
+
+  /* the null symbol has no characters, but still refers to a null terminated
+   * string so that c_str() never returns nullptr
+   */
+  value_type const* c_str () const noexcept {
+    static constexpr value_type empty[1] { };
+    return this->entry ? this->entry->view.data() : empty;
+  }
+
+  size_type size () const noexcept { return this->view().size(); }
+  bool empty () const noexcept { return this->view().empty(); }
+
+  /* position in the order symbols were interned; undefined for the null
+   * symbol
+   */
+  size_type id () const noexcept { return this->entry->id; }
+
+  bool operator == (basic_symbol const& that) const noexcept {
+    return this->entry == that.entry;
+  }
+
+  bool operator != (basic_symbol const& that) const noexcept {
+    return this->entry != that.entry;
+  }
+
+  /* orders by interning order, which is stable across runs for the same input,
+   * unlike ordering by address. The null symbol sorts first.
+   */
+  bool operator < (basic_symbol const& that) const noexcept {
+    return that.entry and (not this->entry or this->id() < that.id());
+  }
+
+  bool operator > (basic_symbol const& that) const noexcept {
+    return that < *this;
+  }
+
+  bool operator <= (basic_symbol const& that) const noexcept {
+    return not (that < *this);
+  }
+
+  bool operator >= (basic_symbol const& that) const noexcept {
+    return not (*this < that);
+  }
+
+private:
+  friend struct basic_intern_pool<CharT, Traits>;
+  friend struct ::std::hash<basic_symbol>;
+
+  using entry_type = impl::symbol_entry<CharT, Traits>;
+
+  explicit basic_symbol (entry_type const* entry) noexcept :
+    entry { entry }
+  { }
+
+  entry_type const* entry { nullptr };
+};
+
+/* deduplicates strings into an arena owned by the pool. Every distinct string
+ * is copied exactly once, and the symbols handed out remain valid until the
+ * pool is cleared or destroyed. Characters are kept in a
+ * monotonic_buffer_resource, while the lookup table is allocated directly from
+ * the upstream resource.
+ *
+ * A pool is not synchronized. Concurrent calls to find are safe, but intern
+ * must not be called while any other thread uses the pool.
+ */
+template <class CharT, class Traits=::std::char_traits<CharT>>
+struct basic_intern_pool final {
+  using symbol_type = basic_symbol<CharT, Traits>;
+  using view_type = basic_string_view<CharT, Traits>;
+  using size_type = ::std::size_t;
+
+  explicit basic_intern_pool (
+    pmr::memory_resource* upstream = pmr::get_default_resource()
+  ) :
+    arena { upstream },
+    slots { pmr::polymorphic_allocator<slot> { upstream } },
+    entries { pmr::polymorphic_allocator<entry_type const*> { upstream } }
+  { }
+
+  basic_intern_pool (basic_intern_pool const&) = delete;
+  basic_intern_pool& operator = (basic_intern_pool const&) = delete;
+
+  pmr::memory_resource* resource () const noexcept {
+    return this->arena.upstream_resource();
+  }
+
+  symbol_type operator [] (size_type id) const noexcept {
+    return symbol_type { this->entries[id] };
+  }
+
+  size_type size () const noexcept { return this->entries.size(); }
+  bool empty () const noexcept { return this->entries.empty(); }
+
+  void reserve (size_type count) {
+    if (count * 2 > this->slots.size()) { this->rehash(count * 2); }
+  }
+
+  /* invalidates every symbol handed out by this pool */
+  void clear () noexcept {
+    this->entries.clear();
+    this->slots.clear();
+    this->arena.release();
+  }
+
+  symbol_type find (view_type str) const noexcept {
+    if (this->slots.empty()) { return symbol_type { }; }
+    auto const hash = hash_of(str);
+    return symbol_type { this->slots[this->probe(str, hash)].entry };
+  }
+
+  symbol_type intern (view_type str) {
+    auto const hash = hash_of(str);
+    if (not this->slots.empty()) {
+      auto const& found = this->slots[this->probe(str, hash)];
+      if (found.entry) { return symbol_type { found.entry }; }
+    }
+    if ((this->entries.size() + 1) * 2 > this->slots.size()) {
+      this->rehash((this->entries.size() + 1) * 2);
+    }
+    auto const entry = this->store(str, hash);
+    this->entries.push_back(entry);
+    this->slots[this->probe(str, hash)].entry = entry;
+    return symbol_type { entry };
+  }
+
+private:
+  using entry_type = impl::symbol_entry<CharT, Traits>;
+
+  struct slot { entry_type const* entry; };
+
+  static ::std::uint64_t hash_of (view_type str) noexcept {
+    return impl::wyhash { }(str.data(), str.size() * sizeof(CharT), 0);
+  }
+
+  /* returns the slot holding str, or the empty slot it would be placed in.
+   * The table is never more than half full, so the probe always terminates.
+   */
+  size_type probe (view_type str, ::std::uint64_t hash) const noexcept {
+    auto const mask = this->slots.size() - 1;
+    auto index = static_cast<size_type>(hash) & mask;
+    while (auto entry = this->slots[index].entry) {
+      if (entry->hash == hash and entry->view == str) { return index; }
+      index = (index + 1) & mask;
+    }
+    return index;
+  }
+
+  void rehash (size_type minimum) {
+    size_type capacity = 16;
+    while (capacity < minimum) { capacity *= 2; }
+    /* keeps push_back in intern from throwing once the entry is stored */
+    this->entries.reserve(capacity / 2);
+    this->slots.assign(capacity, slot { nullptr });
+    auto const mask = capacity - 1;
+    for (auto entry : this->entries) {
+      auto index = static_cast<size_type>(entry->hash) & mask;
+      while (this->slots[index].entry) { index = (index + 1) & mask; }
+      this->slots[index].entry = entry;
+    }
+  }
+
+  entry_type const* store (view_type str, ::std::uint64_t hash) {
+    auto const bytes = sizeof(entry_type) + (str.size() + 1) * sizeof(CharT);
+    auto memory = static_cast<char*>(
+      this->arena.allocate(bytes, alignof(entry_type))
+    );
+    auto data = reinterpret_cast<CharT*>(memory + sizeof(entry_type));
+    Traits::copy(data, str.data(), str.size());
+    Traits::assign(data[str.size()], CharT { });
+    return ::new (memory) entry_type {
+      view_type { data, str.size() },
+      hash,
+      this->entries.size()
+    };
+  }
+
+  pmr::monotonic_buffer_resource arena;
+  ::std::vector<slot, pmr::polymorphic_allocator<slot>> slots;
+  ::std::vector<
+    entry_type const*,
+    pmr::polymorphic_allocator<entry_type const*>
+  > entries;
+};
+
+using symbol = basic_symbol<char>;
+using wsymbol = basic_symbol<wchar_t>;
+using u16symbol = basic_symbol<char16_t>;
+using u32symbol = basic_symbol<char32_t>;
+
+using intern_pool = basic_intern_pool<char>;
+using wintern_pool = basic_intern_pool<wchar_t>;
+using u16intern_pool = basic_intern_pool<char16_t>;
+using u32intern_pool = basic_intern_pool<char32_t>;
+
+}} /* namespace core::v2 */
+
+namespace std {
+
+template <class CharT, class Traits>
+struct hash<core::v2::basic_symbol<CharT, Traits>> {
+  using argument_type = core::v2::basic_symbol<CharT, Traits>;
+  using result_type = size_t;
+
+  result_type operator ()(argument_type const& sym) const noexcept {
+    return sym.entry ? static_cast<result_type>(sym.entry->hash) : 0;
+  }
+};
+
+} /* namespace std */
+
+#endif /* CORE_INTERN_HPP */
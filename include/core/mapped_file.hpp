@@ -0,0 +1,338 @@
+#ifndef CORE_MAPPED_FILE_HPP
+#define CORE_MAPPED_FILE_HPP
+
+#include <system_error>
+#include <algorithm>
+#include <string>
+
+#include <cstdint>
+#include <cerrno>
+
+#include <core/string_view.hpp>
+#include <core/optional.hpp>
+#include <core/range.hpp>
+
+#if defined(_WIN32)
+  #ifndef WIN32_LEAN_AND_MEAN
+    #define WIN32_LEAN_AND_MEAN
+  #endif /* WIN32_LEAN_AND_MEAN */
+  #ifndef NOMINMAX
+    #define NOMINMAX
+  #endif /* NOMINMAX */
+  #include <windows.h>
+#else
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <fcntl.h>
+  #include <unistd.h>
+#endif /* defined(_WIN32) */
+
+namespace core {
+inline namespace v2 {
+
+/* maps an entire file read-only into memory for as long as it lives. The file
+ * may be closed or renamed once mapped, but modifying or truncating it while
+ * mapped is undefined behavior.
+ */
+struct mapped_file final {
+  using value_type = char;
+  using size_type = ::std::size_t;
+  using const_iterator = char const*;
+  using iterator = const_iterator;
+
+  enum class advice {
+    normal,
+    sequential,
+    random,
+    willneed,
+    dontneed,
+    huge_pages
+  };
+
+  mapped_file () noexcept = default;
+
+  /* throws std::system_error if the file cannot be opened or mapped. When
+   * hint is advice::huge_pages, the mapping is aligned to 2 MiB so that the
+   * kernel can back it with huge pages where the filesystem supports it.
+   */
+  explicit mapped_file (char const* path, advice hint=advice::normal) {
+    auto const error = this->map(path, hint);
+    if (error) { throw_system_error(error); }
+  }
+
+  explicit mapped_file (
+    ::std::string const& path,
+    advice hint=advice::normal
+  ) : mapped_file { path.c_str(), hint } { }
+
+  mapped_file (mapped_file const&) = delete;
+
+  mapped_file (mapped_file&& that) noexcept :
+    pointer { that.pointer },
+    length { that.length },
+    mapping { that.mapping },
+    reserved { that.reserved }
+  {
+    that.pointer = nullptr;
+    that.length = 0;
+    that.mapping = nullptr;
+    that.reserved = 0;
+  }
+
+  ~mapped_file () noexcept { this->close(); }
+
+  mapped_file& operator = (mapped_file const&) = delete;
+
+  mapped_file& operator = (mapped_file&& that) noexcept {
+    mapped_file { ::core::move(that) }.swap(*this);
+    return *this;
+  }
+
+  /* the non-throwing alternative to the constructor. Any existing mapping is
+   * released first.
+   */
+  ::std::error_condition open (char const* path, advice hint=advice::normal) {
+    this->close();
+    return this->map(path, hint);
+  }
+
+  void swap (mapped_file& that) noexcept {
+    using ::std::swap;
+    swap(this->pointer, that.pointer);
+    swap(this->length, that.length);
+    swap(this->mapping, that.mapping);
+    swap(this->reserved, that.reserved);
+  }
+
+  void close () noexcept {
+    if (not this->mapping) { return; }
+#if defined(_WIN32)
+    ::UnmapViewOfFile(this->mapping);
+#else
+    ::munmap(this->mapping, this->reserved);
+#endif /* defined(_WIN32) */
+    this->pointer = nullptr;
+    this->length = 0;
+    this->mapping = nullptr;
+    this->reserved = 0;
+  }
+
+  /* applies hint to the bytes in [offset, offset + count), clamped to the
+   * file. Returns false if the platform rejected or does not support it, which
+   * is never an error.
+   */
+  bool advise (
+    advice hint,
+    size_type offset=0,
+    size_type count=string_view::npos
+  ) const noexcept {
+    if (offset >= this->length) { return false; }
+    count = ::std::min(count, this->length - offset);
+#if defined(_WIN32)
+  #if defined(_WIN32_WINNT) and _WIN32_WINNT >= 0x0602
+    if (hint != advice::willneed) { return false; }
+    WIN32_MEMORY_RANGE_ENTRY entry {
+      const_cast<char*>(this->pointer + offset),
+      count
+    };
+    return ::PrefetchVirtualMemory(::GetCurrentProcess(), 1, &entry, 0);
+  #else
+    return static_cast<void>(hint), false;
+  #endif /* _WIN32_WINNT >= 0x0602 */
+#else
+    /* madvise needs a page aligned address */
+    auto const page = static_cast<size_type>(::sysconf(_SC_PAGESIZE));
+    auto const address = reinterpret_cast<::std::uintptr_t>(
+      this->pointer + offset
+    );
+    auto const start = address & ~(page - 1);
+    auto const size = count + (address - start);
+    return ::madvise(
+      reinterpret_cast<void*>(start),
+      size,
+      native_advice(hint)
+    ) == 0;
+#endif /* defined(_WIN32) */
+  }
+
+  explicit operator bool () const noexcept { return this->mapping; }
+  operator string_view () const noexcept { return this->view(); }
+
+  string_view view () const noexcept {
+    return string_view { this->pointer, this->length };
+  }
+
+  range<unsigned char const*> bytes () const noexcept {
+    auto const data = reinterpret_cast<unsigned char const*>(this->pointer);
+    return make_range(data, data + this->length);
+  }
+
+  const_iterator begin () const noexcept { return this->pointer; }
+  const_iterator end () const noexcept { return this->pointer + this->length; }
+
+  char const* data () const noexcept { return this->pointer; }
+  size_type size () const noexcept { return this->length; }
+  bool empty () const noexcept { return not this->length; }
+
+private:
+#if not defined(_WIN32)
+  static int native_advice (advice hint) noexcept {
+    switch (hint) {
+      case advice::sequential: return MADV_SEQUENTIAL;
+      case advice::random: return MADV_RANDOM;
+      case advice::willneed: return MADV_WILLNEED;
+      case advice::dontneed: return MADV_DONTNEED;
+#if defined(MADV_HUGEPAGE)
+      case advice::huge_pages: return MADV_HUGEPAGE;
+#endif /* defined(MADV_HUGEPAGE) */
+      default: return MADV_NORMAL;
+    }
+  }
+
+  static ::std::error_condition last_error () noexcept {
+    return ::std::error_condition { errno, ::std::system_category() };
+  }
+
+  /* reserves address space with 2 MiB of slack, maps the file over it at the
+   * first 2 MiB boundary, and returns the unused ends to the system
+   */
+  ::std::error_condition map_aligned (int fd, size_type size) noexcept {
+    constexpr size_type huge = size_type { 1 } << 21;
+    auto const page = static_cast<size_type>(::sysconf(_SC_PAGESIZE));
+    auto const rounded = (size + page - 1) & ~(page - 1);
+    auto const reservation = ::mmap(
+      nullptr,
+      rounded + huge,
+      PROT_NONE,
+      MAP_PRIVATE | MAP_ANONYMOUS,
+      -1,
+      0
+    );
+    if (reservation == MAP_FAILED) { return last_error(); }
+    auto const base = reinterpret_cast<::std::uintptr_t>(reservation);
+    auto const aligned = (base + huge - 1) & ~(huge - 1);
+    auto const address = ::mmap(
+      reinterpret_cast<void*>(aligned),
+      size,
+      PROT_READ,
+      MAP_SHARED | MAP_FIXED,
+      fd,
+      0
+    );
+    if (address == MAP_FAILED) {
+      auto const error = last_error();
+      ::munmap(reservation, rounded + huge);
+      return error;
+    }
+    if (aligned != base) { ::munmap(reservation, aligned - base); }
+    auto const tail = base + rounded + huge - (aligned + rounded);
+    if (tail) { ::munmap(reinterpret_cast<void*>(aligned + rounded), tail); }
+    this->mapping = address;
+    this->reserved = rounded;
+    return ::std::error_condition { };
+  }
+#endif /* not defined(_WIN32) */
+
+  ::std::error_condition map (char const* path, advice hint) noexcept {
+#if defined(_WIN32)
+    auto const error = [] {
+      return ::std::error_condition {
+        static_cast<int>(::GetLastError()),
+        ::std::system_category()
+      };
+    };
+    auto const file = ::CreateFileA(
+      path,
+      GENERIC_READ,
+      FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+      nullptr,
+      OPEN_EXISTING,
+      hint == advice::sequential
+        ? FILE_FLAG_SEQUENTIAL_SCAN
+        : hint == advice::random ? FILE_FLAG_RANDOM_ACCESS : 0,
+      nullptr
+    );
+    if (file == INVALID_HANDLE_VALUE) { return error(); }
+    LARGE_INTEGER size;
+    if (not ::GetFileSizeEx(file, &size)) {
+      auto const result = error();
+      ::CloseHandle(file);
+      return result;
+    }
+    if (not size.QuadPart) {
+      ::CloseHandle(file);
+      return ::std::error_condition { };
+    }
+    auto const section = ::CreateFileMappingA(
+      file,
+      nullptr,
+      PAGE_READONLY,
+      0,
+      0,
+      nullptr
+    );
+    auto result = section ? ::std::error_condition { } : error();
+    ::CloseHandle(file);
+    if (result) { return result; }
+    auto const view = ::MapViewOfFile(section, FILE_MAP_READ, 0, 0, 0);
+    if (not view) { result = error(); }
+    ::CloseHandle(section);
+    if (result) { return result; }
+    this->mapping = view;
+    this->pointer = static_cast<char const*>(view);
+    this->length = static_cast<size_type>(size.QuadPart);
+    if (hint == advice::willneed) { this->advise(hint); }
+    return result;
+#else
+    auto const fd = ::open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) { return last_error(); }
+    struct stat info;
+    if (::fstat(fd, &info) != 0) {
+      auto const error = last_error();
+      ::close(fd);
+      return error;
+    }
+    auto const size = static_cast<size_type>(info.st_size);
+    if (not size) {
+      ::close(fd);
+      return ::std::error_condition { };
+    }
+    ::std::error_condition error { };
+    if (hint == advice::huge_pages) { error = this->map_aligned(fd, size); }
+    else {
+      auto const address = ::mmap(
+        nullptr,
+        size,
+        PROT_READ,
+        MAP_SHARED,
+        fd,
+        0
+      );
+      if (address == MAP_FAILED) { error = last_error(); }
+      else {
+        this->mapping = address;
+        this->reserved = size;
+      }
+    }
+    ::close(fd);
+    if (error) { return error; }
+    this->pointer = static_cast<char const*>(this->mapping);
+    this->length = size;
+    if (hint != advice::normal) { this->advise(hint); }
+    return error;
+#endif /* defined(_WIN32) */
+  }
+
+  char const* pointer { nullptr };
+  size_type length { 0 };
+  void* mapping { nullptr };
+  size_type reserved { 0 };
+};
+
+inline void swap (mapped_file& lhs, mapped_file& rhs) noexcept {
+  lhs.swap(rhs);
+}
+
+}} /* namespace core::v2 */
+
+#endif /* CORE_MAPPED_FILE_HPP */
@@ -127,17 +127,129 @@ protected:
   virtual bool do_is_equal (memory_resource const&) const noexcept = 0;
 };
 
+/* hands out memory by bumping a pointer through a buffer, and only returns
+ * memory to the upstream resource when released or destroyed. Each buffer
+ * obtained from upstream is twice the size of the last, and starts with a
+ * header linking it to the previous one.
+ */
 struct monotonic_buffer_resource : memory_resource {
 
-  virtual ~monotonic_buffer_resource () noexcept { }
+  explicit monotonic_buffer_resource (memory_resource* upstream) noexcept :
+    upstream { upstream }
+  { }
+
+  monotonic_buffer_resource (
+    ::std::size_t initial_size,
+    memory_resource* upstream
+  ) noexcept :
+    upstream { upstream },
+    first_size { initial_size ? initial_size : 1 },
+    next_size { first_size }
+  { }
+
+  monotonic_buffer_resource (
+    void* buffer,
+    ::std::size_t size,
+    memory_resource* upstream
+  ) noexcept :
+    upstream { upstream },
+    initial_buffer { buffer },
+    initial_size { size },
+    current { buffer },
+    space { size },
+    first_size { size ? size * 2 : default_size },
+    next_size { first_size }
+  { }
+
+  explicit monotonic_buffer_resource (::std::size_t initial_size) noexcept :
+    monotonic_buffer_resource { initial_size, get_default_resource() }
+  { }
+
+  monotonic_buffer_resource (void* buffer, ::std::size_t size) noexcept :
+    monotonic_buffer_resource { buffer, size, get_default_resource() }
+  { }
+
+  monotonic_buffer_resource () noexcept :
+    monotonic_buffer_resource { get_default_resource() }
+  { }
+
+  monotonic_buffer_resource (monotonic_buffer_resource const&) = delete;
+
+  virtual ~monotonic_buffer_resource () noexcept { this->release(); }
 
   monotonic_buffer_resource& operator = (
     monotonic_buffer_resource const&
   ) = delete;
 
+  memory_resource* upstream_resource () const noexcept {
+    return this->upstream;
+  }
+
+  void release () noexcept {
+    while (this->chunks) {
+      auto const chunk = this->chunks;
+      this->chunks = chunk->previous;
+      this->upstream->deallocate(chunk, chunk->size, chunk->alignment);
+    }
+    this->current = this->initial_buffer;
+    this->space = this->initial_size;
+    this->next_size = this->first_size;
+  }
+
 protected:
 
+  virtual void* do_allocate (
+    ::std::size_t bytes,
+    ::std::size_t alignment
+  ) override {
+    if (not bytes) { bytes = 1; }
+    if (auto ptr = ::std::align(alignment, bytes, this->current, this->space)) {
+      this->current = static_cast<char*>(ptr) + bytes;
+      this->space -= bytes;
+      return ptr;
+    }
+    this->grow(bytes, alignment);
+    auto ptr = ::std::align(alignment, bytes, this->current, this->space);
+    this->current = static_cast<char*>(ptr) + bytes;
+    this->space -= bytes;
+    return ptr;
+  }
+
   virtual void do_deallocate (void*, ::std::size_t, ::std::size_t) override { }
+
+  virtual bool do_is_equal (
+    memory_resource const& that
+  ) const noexcept override { return this == ::std::addressof(that); }
+
+private:
+  struct chunk_header {
+    chunk_header* previous;
+    ::std::size_t size;
+    ::std::size_t alignment;
+  };
+
+  enum : ::std::size_t { default_size = 1024 };
+
+  void grow (::std::size_t bytes, ::std::size_t alignment) {
+    alignment = ::std::max(alignment, alignof(chunk_header));
+    auto const needed = sizeof(chunk_header) + bytes + alignment;
+    auto size = ::std::max(this->next_size, needed);
+    auto memory = this->upstream->allocate(size, alignment);
+    auto chunk = ::new (memory) chunk_header { this->chunks, size, alignment };
+    this->chunks = chunk;
+    this->current = chunk + 1;
+    this->space = size - sizeof(chunk_header);
+    this->next_size = size * 2;
+  }
+
+  memory_resource* upstream;
+  void* initial_buffer { nullptr };
+  ::std::size_t initial_size { 0 };
+  void* current { nullptr };
+  ::std::size_t space { 0 };
+  ::std::size_t first_size { default_size };
+  ::std::size_t next_size { default_size };
+  chunk_header* chunks { nullptr };
 };
 
 inline memory_resource* set_default_resource (memory_resource* mr) noexcept {
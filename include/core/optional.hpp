@@ -5,6 +5,9 @@
 #include <system_error>
 #include <functional>
 #include <memory>
+#include <atomic>
+#include <limits>
+#include <string>
 
 #include <cstdlib>
 #include <cstdint>
@@ -13,8 +16,9 @@
 #include <core/functional.hpp>
 #include <core/utility.hpp>
 
-#ifndef CORE_NO_EXCEPTIONS
 #include <exception>
+
+#ifndef CORE_NO_EXCEPTIONS
 #include <stdexcept>
 #endif /* CORE_NO_EXCEPTIONS */
 
@@ -46,12 +50,24 @@ using has_no_addressof_overload = meta::all_t<
   is_detected<addressof_builtin_t, T>::value
 >;
 
+/* comparison operators for expected<T, E> do not participate for the
+ * std::exception_ptr form, which provides its own.
+ */
+template <class E>
+using error_comparison_t = meta::unless<
+  ::std::is_same<E, ::std::exception_ptr>::value,
+  bool
+>;
+
 struct place_t { };
 constexpr place_t place { };
 
 /* this is the default 'false' case */
-template <class T, bool = ::std::is_trivially_destructible<T>::value>
-struct storage {
+template <
+  class T,
+  bool = ::std::is_trivially_destructible<T>::value,
+  bool = ::std::is_trivially_copyable<T>::value
+> struct storage {
   using value_type = T;
   static constexpr bool nothrow = ::std::is_nothrow_move_constructible<
     value_type
@@ -95,10 +111,40 @@ struct storage {
   { }
 
   ~storage () noexcept { if (this->engaged) { this->val.~value_type(); } }
+
+  storage& operator = (storage const& that) {
+    if (this->engaged and that.engaged) { this->val = that.val; }
+    else if (that.engaged) {
+      ::new (::core::as_void(this->val)) value_type(that.val);
+      this->engaged = true;
+    } else if (this->engaged) {
+      this->val.~value_type();
+      this->engaged = false;
+    }
+    return *this;
+  }
+
+  storage& operator = (storage&& that) noexcept(
+    meta::all<
+      ::std::is_nothrow_move_assignable<value_type>::value,
+      nothrow
+    >()
+  ) {
+    if (this->engaged and that.engaged) {
+      this->val = ::core::move(that.val);
+    } else if (that.engaged) {
+      ::new (::core::as_void(this->val)) value_type(::core::move(that.val));
+      this->engaged = true;
+    } else if (this->engaged) {
+      this->val.~value_type();
+      this->engaged = false;
+    }
+    return *this;
+  }
 };
 
 template <class T>
-struct storage<T, true> {
+struct storage<T, true, false> {
   using value_type = T;
   static constexpr bool nothrow = ::std::is_nothrow_move_constructible<
     value_type
@@ -139,6 +185,202 @@ struct storage<T, true> {
     val(::core::forward<Args>(args)...),
     engaged { true }
   { }
+
+  storage& operator = (storage const& that) {
+    if (this->engaged and that.engaged) { this->val = that.val; }
+    else if (that.engaged) {
+      ::new (::core::as_void(this->val)) value_type(that.val);
+    }
+    this->engaged = that.engaged;
+    return *this;
+  }
+
+  storage& operator = (storage&& that) noexcept(
+    meta::all<
+      ::std::is_nothrow_move_assignable<value_type>::value,
+      nothrow
+    >()
+  ) {
+    if (this->engaged and that.engaged) {
+      this->val = ::core::move(that.val);
+    } else if (that.engaged) {
+      ::new (::core::as_void(this->val)) value_type(::core::move(that.val));
+    }
+    this->engaged = that.engaged;
+    return *this;
+  }
+};
+
+/* trivially copyable values leave every special member trivial, so that an
+ * optional<T> can be copied with memcpy and passed in registers
+ */
+template <class T>
+struct storage<T, true, true> {
+  using value_type = T;
+  static constexpr bool nothrow = true;
+  union {
+    ::std::uint8_t dummy;
+    value_type val;
+  };
+  bool engaged { false };
+
+  constexpr storage () noexcept : dummy { } { }
+
+  constexpr storage (value_type const& value) noexcept :
+    val(value),
+    engaged { true }
+  { }
+
+  template <class... Args>
+  constexpr explicit storage (place_t, Args&&... args) :
+    val(::core::forward<Args>(args)...),
+    engaged { true }
+  { }
+};
+
+struct unexpect_t { };
+constexpr unexpect_t unexpect { };
+
+/* shared by expected<T, E> and result<T>. this is the default 'false' case,
+ * where either the value or the error needs its special members called.
+ */
+template <
+  class T,
+  class E,
+  bool = meta::all<
+    ::std::is_trivially_copyable<T>::value,
+    ::std::is_trivially_copyable<E>::value
+  >()
+> struct either_storage {
+  using value_type = T;
+  using error_type = E;
+
+  static constexpr bool nothrow = meta::all<
+    ::std::is_nothrow_move_constructible<value_type>::value,
+    ::std::is_nothrow_move_constructible<error_type>::value
+  >();
+
+  template <class... Args>
+  explicit either_storage (place_t, Args&&... args) :
+    val(::core::forward<Args>(args)...),
+    valid { true }
+  { }
+
+  template <class... Args>
+  explicit either_storage (unexpect_t, Args&&... args) :
+    err(::core::forward<Args>(args)...),
+    valid { false }
+  { }
+
+  either_storage (either_storage const& that) :
+    valid { that.valid }
+  {
+    if (this->valid) {
+      ::new (::core::as_void(this->val)) value_type(that.val);
+    } else { ::new (::core::as_void(this->err)) error_type(that.err); }
+  }
+
+  either_storage (either_storage&& that) noexcept(nothrow) :
+    valid { that.valid }
+  {
+    if (this->valid) {
+      ::new (::core::as_void(this->val)) value_type(::core::move(that.val));
+    } else {
+      ::new (::core::as_void(this->err)) error_type(::core::move(that.err));
+    }
+  }
+
+  ~either_storage () noexcept { this->reset(); }
+
+  either_storage& operator = (either_storage const& that) {
+    either_storage { that }.swap(*this);
+    return *this;
+  }
+
+  either_storage& operator = (either_storage&& that) noexcept(
+    meta::all<
+      nothrow,
+      is_nothrow_swappable<value_type>::value,
+      is_nothrow_swappable<error_type>::value
+    >()
+  ) {
+    either_storage { ::core::move(that) }.swap(*this);
+    return *this;
+  }
+
+  void swap (either_storage& that) noexcept(
+    meta::all<
+      nothrow,
+      is_nothrow_swappable<value_type>::value,
+      is_nothrow_swappable<error_type>::value
+    >()
+  ) {
+    using ::std::swap;
+    if (not this->valid and not that.valid) {
+      swap(this->err, that.err);
+      return;
+    }
+    if (this->valid and that.valid) {
+      swap(this->val, that.val);
+      return;
+    }
+    auto& to_invalidate = this->valid ? *this : that;
+    auto& to_validate = this->valid ? that : *this;
+    value_type value(::core::move(to_invalidate.val));
+    error_type error(::core::move(to_validate.err));
+    to_validate.reset();
+    ::new (::core::as_void(to_validate.val)) value_type(::core::move(value));
+    to_validate.valid = true;
+    to_invalidate.reset();
+    ::new (::core::as_void(to_invalidate.err)) error_type(::core::move(error));
+    to_invalidate.valid = false;
+  }
+
+  void reset () noexcept {
+    if (this->valid) { this->val.~value_type(); }
+    else { this->err.~error_type(); }
+  }
+
+  union {
+    value_type val;
+    error_type err;
+  };
+  bool valid;
+};
+
+/* trivially copyable values and errors leave every special member trivial */
+template <class T, class E>
+struct either_storage<T, E, true> {
+  using value_type = T;
+  using error_type = E;
+
+  static constexpr bool nothrow = true;
+
+  template <class... Args>
+  explicit either_storage (place_t, Args&&... args) :
+    val(::core::forward<Args>(args)...),
+    valid { true }
+  { }
+
+  template <class... Args>
+  explicit either_storage (unexpect_t, Args&&... args) :
+    err(::core::forward<Args>(args)...),
+    valid { false }
+  { }
+
+  void swap (either_storage& that) noexcept {
+    auto const temp = *this;
+    *this = that;
+    that = temp;
+  }
+
+  void reset () noexcept { }
+
+  union {
+    value_type val;
+    error_type err;
+  };
+  bool valid;
 };
 
 } /* namespace impl */
@@ -177,6 +419,28 @@ struct bad_result_condition final : ::std::logic_error {
 [[noreturn]] inline void throw_system_error (::std::error_condition e) {
   throw ::std::system_error { e.value(), e.category() };
 }
+
+[[noreturn]] inline void throw_bad_expected_type (char const* msg) {
+  throw bad_expected_type { msg };
+}
+
+template <class E>
+struct bad_expected_access final : bad_expected_type {
+  explicit bad_expected_access (E e) :
+    bad_expected_type { "expected<T, E> is invalid" },
+    err(::core::move(e))
+  { }
+
+  E const& error () const noexcept { return this->err; }
+
+private:
+  E err;
+};
+
+template <class E>
+[[noreturn]] void throw_bad_expected_access (E const& e) {
+  throw bad_expected_access<E> { e };
+}
 #else /* CORE_NO_EXCEPTIONS */
 [[noreturn]] inline void throw_bad_optional_access () { ::std::abort(); }
 [[noreturn]] inline void throw_bad_result_condition () { ::std::abort(); }
@@ -184,6 +448,68 @@ struct bad_result_condition final : ::std::logic_error {
 [[noreturn]] inline void throw_system_error (::std::error_condition) {
   ::std::abort();
 }
+[[noreturn]] inline void throw_bad_expected_type (char const*) {
+  ::std::abort();
+}
+template <class E>
+[[noreturn]] void throw_bad_expected_access (E const&) { ::std::abort(); }
+#endif /* CORE_NO_EXCEPTIONS */
+
+/* Wraps an error value so that it may be distinguished from a value when
+ * constructing or assigning an expected<T, E>.
+ */
+template <class E>
+struct unexpected final {
+  using error_type = E;
+
+  static_assert(
+    ::std::is_object<error_type>::value,
+    "Cannot have unexpected with non-object type (ill-formed)"
+  );
+
+  static_assert(
+    not ::std::is_array<error_type>::value,
+    "Cannot have unexpected with an array type (ill-formed)"
+  );
+
+  constexpr explicit unexpected (error_type const& e) : err(e) { }
+  constexpr explicit unexpected (error_type&& e) noexcept(
+    ::std::is_nothrow_move_constructible<error_type>::value
+  ) : err(::core::move(e)) { }
+
+  constexpr error_type const& value () const& noexcept { return this->err; }
+  error_type& value () & noexcept { return this->err; }
+  error_type&& value () && noexcept { return ::core::move(this->err); }
+
+private:
+  error_type err;
+};
+
+template <class E>
+constexpr bool operator == (
+  unexpected<E> const& lhs,
+  unexpected<E> const& rhs
+) { return lhs.value() == rhs.value(); }
+
+template <class E>
+constexpr bool operator != (
+  unexpected<E> const& lhs,
+  unexpected<E> const& rhs
+) { return not (lhs == rhs); }
+
+template <class E>
+constexpr auto make_unexpected (E&& e) -> unexpected<decay_t<E>> {
+  return unexpected<decay_t<E>> { ::core::forward<E>(e) };
+}
+
+/* The single parameter form (which holds a std::exception_ptr) is only
+ * available when exceptions are enabled. Otherwise, the error type must be
+ * named and may not be a std::exception_ptr.
+ */
+#ifndef CORE_NO_EXCEPTIONS
+template <class Type, class Error=::std::exception_ptr> struct expected;
+#else /* CORE_NO_EXCEPTIONS */
+template <class Type, class Error> struct expected;
 #endif /* CORE_NO_EXCEPTIONS */
 
 template <class Type>
@@ -192,11 +518,6 @@ struct optional final : private impl::storage<Type> {
   using value_type = typename impl::storage<Type>::value_type;
 
   /* compiler enforcement */
-  static_assert(
-    not ::std::is_reference<value_type>::value,
-    "Cannot have optional reference (ill-formed)"
-  );
-
   static_assert(
     not ::std::is_same<decay_t<value_type>, nullopt_t>::value,
     "Cannot have optional<nullopt_t> (ill-formed)"
@@ -265,20 +586,8 @@ struct optional final : private impl::storage<Type> {
     Args&&... args
   ) : base { impl::place, il, ::core::forward<Args>(args)... } { }
 
-  optional& operator = (optional const& that) {
-    optional { that }.swap(*this);
-    return *this;
-  }
-
-  optional& operator = (optional&& that) noexcept (
-    meta::all<
-      ::std::is_nothrow_move_assignable<value_type>::value,
-      ::std::is_nothrow_move_constructible<value_type>::value
-    >()
-  ) {
-    optional { ::core::move(that) }.swap(*this);
-    return *this;
-  }
+  optional& operator = (optional const&) = default;
+  optional& operator = (optional&&) = default;
 
   template <
     class T,
@@ -391,6 +700,60 @@ struct optional final : private impl::storage<Type> {
       : static_cast<value_type>(::core::forward<T>(val));
   }
 
+  template <class F>
+  auto map (F&& f) const& -> optional<
+    decay_t<invoke_of_t<F, value_type const&>>
+  > {
+    if (not *this) { return nullopt; }
+    return ::core::invoke(::core::forward<F>(f), **this);
+  }
+
+  template <class F>
+  auto map (F&& f) & -> optional<
+    decay_t<invoke_of_t<F, value_type&>>
+  > {
+    if (not *this) { return nullopt; }
+    return ::core::invoke(::core::forward<F>(f), **this);
+  }
+
+  template <class F>
+  auto map (F&& f) && -> optional<
+    decay_t<invoke_of_t<F, value_type&&>>
+  > {
+    if (not *this) { return nullopt; }
+    return ::core::invoke(::core::forward<F>(f), ::core::move(**this));
+  }
+
+  template <class F>
+  auto and_then (F&& f) const& -> decay_t<invoke_of_t<F, value_type const&>> {
+    if (not *this) { return nullopt; }
+    return ::core::invoke(::core::forward<F>(f), **this);
+  }
+
+  template <class F>
+  auto and_then (F&& f) & -> decay_t<invoke_of_t<F, value_type&>> {
+    if (not *this) { return nullopt; }
+    return ::core::invoke(::core::forward<F>(f), **this);
+  }
+
+  template <class F>
+  auto and_then (F&& f) && -> decay_t<invoke_of_t<F, value_type&&>> {
+    if (not *this) { return nullopt; }
+    return ::core::invoke(::core::forward<F>(f), ::core::move(**this));
+  }
+
+  template <class F>
+  optional or_else (F&& f) const& {
+    if (*this) { return *this; }
+    return ::core::invoke(::core::forward<F>(f));
+  }
+
+  template <class F>
+  optional or_else (F&& f) && {
+    if (*this) { return ::core::move(*this); }
+    return ::core::invoke(::core::forward<F>(f));
+  }
+
 private:
   constexpr value_type const* ptr (::std::false_type) const noexcept {
     return &this->val;
@@ -401,65 +764,430 @@ private:
   }
 };
 
-#ifndef CORE_NO_EXCEPTIONS
+/* optional<T&> is a nullable pointer with the optional interface. It never
+ * owns its referent, and assigning an optional<T&> rebinds it rather than
+ * assigning through it.
+ */
 template <class Type>
-struct expected final {
-  using value_type = Type;
-  using error_type = ::std::exception_ptr;
-
-  static constexpr bool nothrow = ::std::is_nothrow_move_constructible<
-    value_type
-  >::value;
+struct optional<Type&> final {
+  using value_type = Type&;
 
-  /* compiler enforcement */
   static_assert(
-    not ::std::is_reference<value_type>::value,
-    "Cannot have expected reference (ill-formed)"
+    not ::std::is_same<remove_cv_t<Type>, nullopt_t>::value,
+    "Cannot have optional<nullopt_t&> (ill-formed)"
   );
 
   static_assert(
-    not ::std::is_same<decay_t<value_type>, nullopt_t>::value,
-    "Cannot have expected<nullopt_t> (ill-formed)"
+    not ::std::is_same<remove_cv_t<Type>, in_place_t>::value,
+    "Cannot have optional<in_place_t&> (ill-formed)"
   );
 
-  static_assert(
-    not ::std::is_same<decay_t<value_type>, in_place_t>::value,
-    "Cannot have expected<in_place_t> (ill-formed)"
-  );
+  constexpr optional () noexcept { }
+  constexpr optional (nullopt_t) noexcept { }
+  optional (value_type value) noexcept : ref { ::std::addressof(value) }
+  { }
 
-  static_assert(
-    not ::std::is_same<decay_t<value_type>, ::std::exception_ptr>::value,
-    "Cannot have expected<std::exception_ptr> (tautological)"
-  );
+  /* prevents an optional<T const&> from binding to a temporary */
+  optional (Type&&) = delete;
 
-  static_assert(
-    ::std::is_object<value_type>::value,
-    "Cannot have expected with non-object type (undefined behavior)"
-  );
+  template <
+    class T,
+    class=meta::when<
+      meta::all<
+        not ::std::is_same<T, Type>::value,
+        ::std::is_convertible<T*, Type*>::value
+      >()
+    >
+  > optional (optional<T&> const& that) noexcept :
+    ref { that ? ::std::addressof(*that) : nullptr }
+  { }
 
-  static_assert(
-    ::std::is_nothrow_destructible<value_type>::value,
-    "Cannot have expected with throwable destructor (undefined behavior)"
-  );
+  optional (optional const&) = default;
+  optional (optional&&) = default;
+  ~optional () = default;
 
-  expected (::std::exception_ptr ptr) noexcept :
-    ptr { ptr }
-  { }
+  optional& operator = (optional const&) = default;
+  optional& operator = (optional&&) = default;
 
-  expected (value_type const& val) :
-    val(val),
-    valid { true }
-  { }
+  optional& operator = (nullopt_t) noexcept {
+    this->ref = nullptr;
+    return *this;
+  }
 
-  expected (value_type&& val) noexcept(nothrow) :
-    val(::core::move(val)),
-    valid { true }
-  { }
+  void swap (optional& that) noexcept {
+    using ::std::swap;
+    swap(this->ref, that.ref);
+  }
 
-  template <
-    class... Args,
-    class=enable_if_t<::std::is_constructible<value_type, Args...>::value>
-  > explicit expected (in_place_t, Args&&... args) :
+  constexpr explicit operator bool () const noexcept {
+    return this->ref != nullptr;
+  }
+
+  constexpr value_type operator * () const noexcept { return *this->ref; }
+  constexpr Type* operator -> () const noexcept { return this->ref; }
+
+  void emplace (value_type value) noexcept {
+    this->ref = ::std::addressof(value);
+  }
+
+  constexpr value_type value () const noexcept(false) {
+    return *this ? **this : (throw_bad_optional_access(), **this);
+  }
+
+  template <
+    class T,
+    class=meta::when<
+      meta::all<
+        ::std::is_copy_constructible<remove_cv_t<Type>>::value,
+        ::std::is_convertible<T, remove_cv_t<Type>>::value
+      >()
+    >
+  > constexpr remove_cv_t<Type> value_or (T&& val) const {
+    return *this
+      ? **this
+      : static_cast<remove_cv_t<Type>>(::core::forward<T>(val));
+  }
+
+  /* a callable that returns an lvalue reference, such as a pointer to data
+   * member, produces another optional reference rather than a copy
+   */
+  template <class F>
+  auto map (F&& f) const -> optional<
+    conditional_t<
+      ::std::is_lvalue_reference<invoke_of_t<F, value_type>>::value,
+      invoke_of_t<F, value_type>,
+      decay_t<invoke_of_t<F, value_type>>
+    >
+  > {
+    if (not *this) { return nullopt; }
+    return ::core::invoke(::core::forward<F>(f), **this);
+  }
+
+  template <class F>
+  auto and_then (F&& f) const -> decay_t<invoke_of_t<F, value_type>> {
+    if (not *this) { return nullopt; }
+    return ::core::invoke(::core::forward<F>(f), **this);
+  }
+
+  template <class F>
+  optional or_else (F&& f) const {
+    if (*this) { return *this; }
+    return ::core::invoke(::core::forward<F>(f));
+  }
+
+private:
+  Type* ref { nullptr };
+};
+
+/* tombstone_traits is the customization point used by compact_optional. A
+ * specialization provides a value of T that is never used as a real value,
+ * which is then used to represent the disengaged state.
+ */
+template <class T, class=void> struct tombstone_traits;
+
+template <class T>
+struct tombstone_traits<T*> {
+  static constexpr T* empty () noexcept { return nullptr; }
+  static constexpr bool is_empty (T* value) noexcept {
+    return value == nullptr;
+  }
+};
+
+template <class T>
+struct tombstone_traits<
+  T,
+  meta::when< ::std::numeric_limits<T>::has_quiet_NaN>
+> {
+  static constexpr T empty () noexcept {
+    return ::std::numeric_limits<T>::quiet_NaN();
+  }
+  static constexpr bool is_empty (T value) noexcept { return value != value; }
+};
+
+/* A set of tombstone traits for integral and enum types, where the tombstone
+ * is given explicitly. e.g., compact_optional<int, sentinel<int, -1>>
+ */
+template <class T, T Value>
+struct sentinel {
+  static constexpr T empty () noexcept { return Value; }
+  static constexpr bool is_empty (T value) noexcept { return value == Value; }
+};
+
+/* An optional that uses a tombstone value of T rather than an engaged flag,
+ * so that sizeof(compact_optional<T>) == sizeof(T). Assigning the tombstone
+ * value itself results in a disengaged compact_optional.
+ */
+template <class Type, class Traits=tombstone_traits<Type>>
+struct compact_optional final {
+  using traits_type = Traits;
+  using value_type = Type;
+
+  static_assert(
+    ::std::is_object<value_type>::value,
+    "Cannot have compact_optional with a non-object type (ill-formed)"
+  );
+
+  static_assert(
+    ::std::is_nothrow_destructible<value_type>::value,
+    "Cannot have compact_optional with throwable destructor (ill-formed)"
+  );
+
+  constexpr compact_optional () noexcept(noexcept(traits_type::empty())) :
+    val(traits_type::empty())
+  { }
+
+  constexpr compact_optional (nullopt_t) noexcept(
+    noexcept(traits_type::empty())
+  ) : val(traits_type::empty()) { }
+
+  constexpr compact_optional (value_type const& value) : val(value) { }
+  constexpr compact_optional (value_type&& value) noexcept(
+    ::std::is_nothrow_move_constructible<value_type>::value
+  ) : val(::core::move(value)) { }
+
+  template <
+    class... Args,
+    class=enable_if_t< ::std::is_constructible<value_type, Args...>::value>
+  > constexpr explicit compact_optional (in_place_t, Args&&... args) :
+    val(::core::forward<Args>(args)...)
+  { }
+
+  compact_optional (compact_optional const&) = default;
+  compact_optional (compact_optional&&) = default;
+  ~compact_optional () = default;
+
+  compact_optional& operator = (compact_optional const&) = default;
+  compact_optional& operator = (compact_optional&&) = default;
+
+  compact_optional& operator = (nullopt_t) {
+    this->val = traits_type::empty();
+    return *this;
+  }
+
+  template <
+    class T,
+    class=enable_if_t<
+      not ::std::is_same<decay_t<T>, compact_optional>::value and
+      ::std::is_assignable<value_type&, T>::value
+    >
+  > compact_optional& operator = (T&& value) {
+    this->val = ::core::forward<T>(value);
+    return *this;
+  }
+
+  void swap (compact_optional& that) noexcept(
+    is_nothrow_swappable<value_type>::value
+  ) {
+    using ::std::swap;
+    swap(this->val, that.val);
+  }
+
+  constexpr explicit operator bool () const noexcept(
+    noexcept(traits_type::is_empty(::std::declval<value_type const&>()))
+  ) { return not traits_type::is_empty(this->val); }
+
+  constexpr value_type const& operator * () const noexcept {
+    return this->val;
+  }
+
+  value_type& operator * () noexcept { return this->val; }
+
+  constexpr value_type const* operator -> () const noexcept {
+    return &this->val;
+  }
+
+  value_type* operator -> () noexcept { return ::std::addressof(this->val); }
+
+  /* constructs in place, so value_type need not be assignable. If the
+   * constructor throws, the tombstone is restored and *this is disengaged.
+   */
+  template <class... Args>
+  void emplace (Args&&... args) {
+    this->val.~value_type();
+#ifndef CORE_NO_EXCEPTIONS
+    try {
+      ::new (::core::as_void(this->val)) value_type(
+        ::core::forward<Args>(args)...
+      );
+    } catch (...) {
+      ::new (::core::as_void(this->val)) value_type(traits_type::empty());
+      throw;
+    }
+#else /* CORE_NO_EXCEPTIONS */
+    ::new (::core::as_void(this->val)) value_type(
+      ::core::forward<Args>(args)...
+    );
+#endif /* CORE_NO_EXCEPTIONS */
+  }
+
+  constexpr value_type const& value () const noexcept(false) {
+    return *this
+      ? **this
+      : (throw_bad_optional_access(), **this);
+  }
+
+  value_type& value () noexcept(false) {
+    if (*this) { return **this; }
+    throw_bad_optional_access();
+  }
+
+  template <
+    class T,
+    class=meta::when< ::std::is_convertible<T, value_type>::value>
+  > constexpr value_type value_or (T&& val) const& {
+    return *this ? **this : static_cast<value_type>(::core::forward<T>(val));
+  }
+
+  template <
+    class T,
+    class=meta::when< ::std::is_convertible<T, value_type>::value>
+  > value_type value_or (T&& val) && {
+    return *this
+      ? value_type { ::core::move(**this) }
+      : static_cast<value_type>(::core::forward<T>(val));
+  }
+
+private:
+  value_type val;
+};
+
+template <class T, class Traits>
+constexpr bool operator == (
+  compact_optional<T, Traits> const& lhs,
+  compact_optional<T, Traits> const& rhs
+) noexcept {
+  return static_cast<bool>(lhs) != static_cast<bool>(rhs)
+    ? false
+    : not lhs or *lhs == *rhs;
+}
+
+template <class T, class Traits>
+constexpr bool operator == (
+  compact_optional<T, Traits> const& lhs,
+  nullopt_t
+) noexcept { return not lhs; }
+
+template <class T, class Traits>
+constexpr bool operator == (
+  nullopt_t,
+  compact_optional<T, Traits> const& rhs
+) noexcept { return not rhs; }
+
+template <class T, class Traits>
+constexpr bool operator == (
+  compact_optional<T, Traits> const& opt,
+  T const& value
+) noexcept { return opt and *opt == value; }
+
+template <class T, class Traits>
+constexpr bool operator == (
+  T const& value,
+  compact_optional<T, Traits> const& opt
+) noexcept { return opt and value == *opt; }
+
+template <class T, class Traits>
+constexpr bool operator != (
+  compact_optional<T, Traits> const& lhs,
+  compact_optional<T, Traits> const& rhs
+) noexcept { return not (lhs == rhs); }
+
+template <class T, class Traits>
+constexpr bool operator != (
+  compact_optional<T, Traits> const& lhs,
+  nullopt_t
+) noexcept { return static_cast<bool>(lhs); }
+
+template <class T, class Traits>
+constexpr bool operator != (
+  nullopt_t,
+  compact_optional<T, Traits> const& rhs
+) noexcept { return static_cast<bool>(rhs); }
+
+template <class T, class Traits>
+constexpr bool operator != (
+  compact_optional<T, Traits> const& opt,
+  T const& value
+) noexcept { return not (opt == value); }
+
+template <class T, class Traits>
+constexpr bool operator != (
+  T const& value,
+  compact_optional<T, Traits> const& opt
+) noexcept { return not (value == opt); }
+
+template <class T, class Traits>
+constexpr bool operator < (
+  compact_optional<T, Traits> const& lhs,
+  compact_optional<T, Traits> const& rhs
+) noexcept {
+  return static_cast<bool>(rhs) == false ? false : not lhs or *lhs < *rhs;
+}
+
+template <class T, class Traits>
+void swap (
+  compact_optional<T, Traits>& lhs,
+  compact_optional<T, Traits>& rhs
+) noexcept(noexcept(lhs.swap(rhs))) { lhs.swap(rhs); }
+
+#ifndef CORE_NO_EXCEPTIONS
+template <class Type>
+struct expected<Type, ::std::exception_ptr> final {
+  using value_type = Type;
+  using error_type = ::std::exception_ptr;
+
+  static constexpr bool nothrow = ::std::is_nothrow_move_constructible<
+    value_type
+  >::value;
+
+  /* compiler enforcement */
+  static_assert(
+    not ::std::is_reference<value_type>::value,
+    "Cannot have expected reference (ill-formed)"
+  );
+
+  static_assert(
+    not ::std::is_same<decay_t<value_type>, nullopt_t>::value,
+    "Cannot have expected<nullopt_t> (ill-formed)"
+  );
+
+  static_assert(
+    not ::std::is_same<decay_t<value_type>, in_place_t>::value,
+    "Cannot have expected<in_place_t> (ill-formed)"
+  );
+
+  static_assert(
+    not ::std::is_same<decay_t<value_type>, ::std::exception_ptr>::value,
+    "Cannot have expected<std::exception_ptr> (tautological)"
+  );
+
+  static_assert(
+    ::std::is_object<value_type>::value,
+    "Cannot have expected with non-object type (undefined behavior)"
+  );
+
+  static_assert(
+    ::std::is_nothrow_destructible<value_type>::value,
+    "Cannot have expected with throwable destructor (undefined behavior)"
+  );
+
+  expected (::std::exception_ptr ptr) noexcept :
+    ptr { ptr }
+  { }
+
+  expected (value_type const& val) :
+    val(val),
+    valid { true }
+  { }
+
+  expected (value_type&& val) noexcept(nothrow) :
+    val(::core::move(val)),
+    valid { true }
+  { }
+
+  template <
+    class... Args,
+    class=enable_if_t<::std::is_constructible<value_type, Args...>::value>
+  > explicit expected (in_place_t, Args&&... args) :
     val(::core::forward<Args>(args)...),
     valid { true }
   { }
@@ -648,6 +1376,60 @@ struct expected final {
       : static_cast<value_type>(::core::forward<T>(val));
   }
 
+  template <class F>
+  auto map (F&& f) const& -> expected<
+    decay_t<invoke_of_t<F, value_type const&>>
+  > {
+    if (not *this) { return this->ptr; }
+    return ::core::invoke(::core::forward<F>(f), **this);
+  }
+
+  template <class F>
+  auto map (F&& f) & -> expected<
+    decay_t<invoke_of_t<F, value_type&>>
+  > {
+    if (not *this) { return this->ptr; }
+    return ::core::invoke(::core::forward<F>(f), **this);
+  }
+
+  template <class F>
+  auto map (F&& f) && -> expected<
+    decay_t<invoke_of_t<F, value_type&&>>
+  > {
+    if (not *this) { return this->ptr; }
+    return ::core::invoke(::core::forward<F>(f), ::core::move(**this));
+  }
+
+  template <class F>
+  auto and_then (F&& f) const& -> decay_t<invoke_of_t<F, value_type const&>> {
+    if (not *this) { return this->ptr; }
+    return ::core::invoke(::core::forward<F>(f), **this);
+  }
+
+  template <class F>
+  auto and_then (F&& f) & -> decay_t<invoke_of_t<F, value_type&>> {
+    if (not *this) { return this->ptr; }
+    return ::core::invoke(::core::forward<F>(f), **this);
+  }
+
+  template <class F>
+  auto and_then (F&& f) && -> decay_t<invoke_of_t<F, value_type&&>> {
+    if (not *this) { return this->ptr; }
+    return ::core::invoke(::core::forward<F>(f), ::core::move(**this));
+  }
+
+  template <class F>
+  expected or_else (F&& f) const& {
+    if (*this) { return *this; }
+    return ::core::invoke(::core::forward<F>(f), this->ptr);
+  }
+
+  template <class F>
+  expected or_else (F&& f) && {
+    if (*this) { return ::core::move(*this); }
+    return ::core::invoke(::core::forward<F>(f), this->ptr);
+  }
+
   template <class E>
   E expect () const noexcept(false) {
     try { this->raise(); }
@@ -669,21 +1451,385 @@ struct expected final {
 
 private:
 
-  void reset () {
-    *this ? this->val.~value_type() : this->ptr.~exception_ptr();
-  }
+  void reset () {
+    *this ? this->val.~value_type() : this->ptr.~exception_ptr();
+  }
+
+  union {
+    value_type val;
+    ::std::exception_ptr ptr;
+  };
+  bool valid { false };
+};
+#endif /* CORE_NO_EXCEPTIONS */
+
+/* expected<T, E> holds either a T or an error of type E. Unlike the
+ * std::exception_ptr form, creating or copying an error requires no
+ * allocation, which makes it suitable for errors that occur frequently.
+ */
+template <class Type, class Error>
+struct expected final : private impl::either_storage<Type, Error> {
+  using base = impl::either_storage<Type, Error>;
+  template <class, class> friend struct expected;
+
+  using value_type = Type;
+  using error_type = Error;
+
+  static constexpr bool nothrow = meta::all<
+    ::std::is_nothrow_move_constructible<value_type>::value,
+    ::std::is_nothrow_move_constructible<error_type>::value
+  >();
+
+  /* compiler enforcement */
+  static_assert(
+    not ::std::is_reference<value_type>::value,
+    "Cannot have expected reference (ill-formed)"
+  );
+
+  static_assert(
+    not ::std::is_same<decay_t<value_type>, in_place_t>::value,
+    "Cannot have expected<in_place_t> (ill-formed)"
+  );
+
+  static_assert(
+    not ::std::is_same<decay_t<value_type>, unexpected<error_type>>::value,
+    "Cannot have expected<unexpected<E>, E> (tautological)"
+  );
+
+#ifdef CORE_NO_EXCEPTIONS
+  static_assert(
+    not ::std::is_same<error_type, ::std::exception_ptr>::value,
+    "Cannot have expected<T, std::exception_ptr> without exceptions"
+  );
+#endif /* CORE_NO_EXCEPTIONS */
+
+  static_assert(
+    ::std::is_object<value_type>::value,
+    "Cannot have expected with non-object type (undefined behavior)"
+  );
+
+  static_assert(
+    ::std::is_object<error_type>::value,
+    "Cannot have expected with non-object error type (undefined behavior)"
+  );
+
+  static_assert(
+    ::std::is_nothrow_destructible<value_type>::value,
+    "Cannot have expected with throwable destructor (undefined behavior)"
+  );
+
+  static_assert(
+    ::std::is_nothrow_destructible<error_type>::value,
+    "Cannot have expected with throwable error destructor (undefined behavior)"
+  );
+
+  expected (unexpected<error_type> const& e) :
+    base { impl::unexpect, e.value() }
+  { }
+
+  expected (unexpected<error_type>&& e) noexcept(
+    ::std::is_nothrow_move_constructible<error_type>::value
+  ) : base { impl::unexpect, ::core::move(e).value() } { }
+
+  expected (value_type const& val) : base { impl::place, val } { }
+
+  expected (value_type&& val) noexcept(
+    ::std::is_nothrow_move_constructible<value_type>::value
+  ) : base { impl::place, ::core::move(val) } { }
+
+  template <
+    class... Args,
+    class=enable_if_t<::std::is_constructible<value_type, Args...>::value>
+  > explicit expected (in_place_t, Args&&... args) :
+    base { impl::place, ::core::forward<Args>(args)... }
+  { }
+
+  expected () : base { impl::place } { }
+
+  expected (expected const&) = default;
+  expected (expected&&) = default;
+  ~expected () = default;
+
+  expected& operator = (expected const&) = default;
+  expected& operator = (expected&&) = default;
+
+  expected& operator = (value_type const& value) {
+    if (not *this) { this->emplace(value); }
+    else { **this = value; }
+    return *this;
+  }
+
+  expected& operator = (value_type&& value) {
+    if (not *this) { this->emplace(::core::move(value)); }
+    else { **this = ::core::move(value); }
+    return *this;
+  }
+
+  expected& operator = (unexpected<error_type> const& e) {
+    if (not *this) { this->err = e.value(); }
+    else { expected { e }.swap(*this); }
+    return *this;
+  }
+
+  expected& operator = (unexpected<error_type>&& e) {
+    if (not *this) { this->err = ::core::move(e).value(); }
+    else { expected { ::core::move(e) }.swap(*this); }
+    return *this;
+  }
+
+  void swap (expected& that) noexcept(
+    meta::all<
+      nothrow,
+      is_nothrow_swappable<value_type>::value,
+      is_nothrow_swappable<error_type>::value
+    >()
+  ) { base::swap(that); }
+
+  explicit operator bool () const noexcept { return this->valid; }
+
+  value_type const& operator * () const noexcept { return this->val; }
+  value_type& operator * () noexcept { return this->val; }
+
+  value_type const* operator -> () const noexcept {
+    return ::std::addressof(this->val);
+  }
+  value_type* operator -> () noexcept { return ::std::addressof(this->val); }
+
+  /* constructed aside first, so that the error is kept if this throws */
+  template <class... Args>
+  void emplace (Args&&... args) {
+    value_type temp(::core::forward<Args>(args)...);
+    this->reset();
+    ::new (::core::as_void(this->val)) value_type(::core::move(temp));
+    this->valid = true;
+  }
+
+  value_type const& value () const noexcept(false) {
+    if (not *this) { throw_bad_expected_access(this->err); }
+    return **this;
+  }
+
+  value_type& value () noexcept(false) {
+    if (not *this) { throw_bad_expected_access(this->err); }
+    return **this;
+  }
+
+  template <
+    class T,
+    class=meta::when<
+      meta::all<
+        ::std::is_copy_constructible<value_type>::value,
+        ::std::is_convertible<T, value_type>::value
+      >()
+    >
+  > value_type value_or (T&& val) const& {
+    return *this ? **this : static_cast<value_type>(::core::forward<T>(val));
+  }
+
+  template <
+    class T,
+    class=meta::when<
+      meta::all<
+        ::std::is_move_constructible<value_type>::value,
+        ::std::is_convertible<T, value_type>::value
+      >()
+    >
+  > value_type value_or (T&& val) && {
+    return *this
+      ? value_type { ::core::move(**this) }
+      : static_cast<value_type>(::core::forward<T>(val));
+  }
+
+  template <class F>
+  auto map (F&& f) const& -> expected<
+    decay_t<invoke_of_t<F, value_type const&>>,
+    error_type
+  > {
+    if (not *this) { return ::core::make_unexpected(this->err); }
+    return ::core::invoke(::core::forward<F>(f), **this);
+  }
+
+  template <class F>
+  auto map (F&& f) & -> expected<
+    decay_t<invoke_of_t<F, value_type&>>,
+    error_type
+  > {
+    if (not *this) { return ::core::make_unexpected(this->err); }
+    return ::core::invoke(::core::forward<F>(f), **this);
+  }
+
+  template <class F>
+  auto map (F&& f) && -> expected<
+    decay_t<invoke_of_t<F, value_type&&>>,
+    error_type
+  > {
+    if (not *this) { return ::core::make_unexpected(::core::move(this->err)); }
+    return ::core::invoke(::core::forward<F>(f), ::core::move(**this));
+  }
+
+  template <class F>
+  auto and_then (F&& f) const& -> decay_t<invoke_of_t<F, value_type const&>> {
+    if (not *this) { return ::core::make_unexpected(this->err); }
+    return ::core::invoke(::core::forward<F>(f), **this);
+  }
+
+  template <class F>
+  auto and_then (F&& f) & -> decay_t<invoke_of_t<F, value_type&>> {
+    if (not *this) { return ::core::make_unexpected(this->err); }
+    return ::core::invoke(::core::forward<F>(f), **this);
+  }
+
+  template <class F>
+  auto and_then (F&& f) && -> decay_t<invoke_of_t<F, value_type&&>> {
+    if (not *this) { return ::core::make_unexpected(::core::move(this->err)); }
+    return ::core::invoke(::core::forward<F>(f), ::core::move(**this));
+  }
+
+  template <class F>
+  expected or_else (F&& f) const& {
+    if (*this) { return *this; }
+    return ::core::invoke(::core::forward<F>(f), this->err);
+  }
+
+  template <class F>
+  expected or_else (F&& f) && {
+    if (*this) { return ::core::move(*this); }
+    return ::core::invoke(::core::forward<F>(f), ::core::move(this->err));
+  }
+
+  error_type const& error () const noexcept(false) {
+    if (*this) { throw_bad_expected_type("expected<T, E> is valid"); }
+    return this->err;
+  }
+
+  error_type& error () noexcept(false) {
+    if (*this) { throw_bad_expected_type("expected<T, E> is valid"); }
+    return this->err;
+  }
+};
+
+namespace impl {
+
+struct status_category final : ::std::error_category {
+  char const* name () const noexcept override { return "core::status"; }
+  ::std::string message (int value) const override {
+    return "unregistered status " + ::std::to_string(value);
+  }
+};
+
+/* atomic so that a domain may be registered while codes in other domains
+ * are being converted on other threads
+ */
+inline ::std::atomic<::std::error_category const*>* status_categories (
+) noexcept {
+  static ::std::atomic<::std::error_category const*> categories[256] {
+    { ::std::addressof(::std::generic_category()) },
+    { ::std::addressof(::std::system_category()) }
+  };
+  return categories;
+}
+
+} /* namespace impl */
+
+/* status_code packs a domain into the high 8 bits and a value into the low
+ * 24 bits of a single 32-bit integer. Values are stored in two's complement
+ * and sign extended on the way out, so any value in [-2^23, 2^23) round
+ * trips; bits above those are discarded. Construction and comparison are
+ * constexpr and never touch a std::error_category; the category is only
+ * looked up when converting to a std::error_condition.
+ */
+struct status_code final {
+  using value_type = ::std::uint32_t;
+
+  enum : ::std::uint8_t { generic_domain = 0, system_domain = 1 };
+
+  constexpr status_code () noexcept : code { 0 } { }
+
+  constexpr status_code (::std::uint8_t domain, int value) noexcept :
+    code {
+      (static_cast<value_type>(domain) << 24) |
+      (static_cast<value_type>(value) & 0xFFFFFFu)
+    }
+  { }
+
+  constexpr status_code (::std::errc e) noexcept :
+    status_code { generic_domain, static_cast<int>(e) }
+  { }
+
+  constexpr ::std::uint8_t domain () const noexcept {
+    return static_cast<::std::uint8_t>(this->code >> 24);
+  }
+
+  constexpr int value () const noexcept {
+    return static_cast<int>((this->code & 0xFFFFFFu) ^ 0x800000u) - 0x800000;
+  }
+
+  static constexpr int min_value () noexcept { return -0x800000; }
+  static constexpr int max_value () noexcept { return 0x7FFFFF; }
+
+  constexpr value_type bits () const noexcept { return this->code; }
+
+  constexpr explicit operator bool () const noexcept {
+    return this->value() != 0;
+  }
+
+  ::std::error_condition condition () const noexcept {
+    return ::std::error_condition { this->value(), this->category() };
+  }
+
+  explicit operator ::std::error_condition () const noexcept {
+    return this->condition();
+  }
+
+  ::std::error_category const& category () const noexcept {
+    static impl::status_category const unregistered { };
+    auto const category = impl::status_categories()[this->domain()].load(
+      ::std::memory_order_acquire
+    );
+    return category ? *category : unregistered;
+  }
+
+private:
+  value_type code;
+};
+
+/* associates a std::error_category with a status_code domain, which is then
+ * used by status_code::condition. Domains 0 and 1 are preregistered as the
+ * generic and system categories.
+ */
+inline void register_status_category (
+  ::std::uint8_t domain,
+  ::std::error_category const& category
+) noexcept {
+  impl::status_categories()[domain].store(
+    ::std::addressof(category),
+    ::std::memory_order_release
+  );
+}
+
+constexpr bool operator == (status_code lhs, status_code rhs) noexcept {
+  return lhs.bits() == rhs.bits();
+}
+
+constexpr bool operator != (status_code lhs, status_code rhs) noexcept {
+  return lhs.bits() != rhs.bits();
+}
 
-  union {
-    value_type val;
-    ::std::exception_ptr ptr;
-  };
-  bool valid { false };
-};
-#endif /* CORE_NO_EXCEPTIONS */
+constexpr bool operator < (status_code lhs, status_code rhs) noexcept {
+  return lhs.bits() < rhs.bits();
+}
 
+/* a result whose error is a status_code rather than a std::error_condition,
+ * which holds both an int and a pointer. status_result<int> is 8 bytes.
+ */
+template <class T> using status_result = expected<T, status_code>;
 
 template <class Type>
-struct result final {
+struct result final : private impl::either_storage<
+  Type,
+  ::std::error_condition
+> {
+  using base = impl::either_storage<Type, ::std::error_condition>;
   template <class U> friend struct result;
 
   using value_type = Type;
@@ -729,37 +1875,21 @@ struct result final {
   );
 
   result (int val, ::std::error_category const& cat) noexcept :
-    valid { val == 0 }
-  {
-    if (*this) { ::new (::core::as_void(this->val)) value_type(); }
-    else { ::new (::core::as_void(this->cnd)) error_type(val, cat); }
-  }
+    result { error_type { val, cat } }
+  { }
 
   template <
     class E,
     class=meta::when<::std::is_error_condition_enum<E>::value>
-  > result (E e) noexcept :
-    valid { core::as_under(e) == 0 }
-  {
-    if (*this) { ::new (as_void(this->val)) value_type(); }
-    else { ::new (as_void(this->cnd)) error_type(e); }
-  }
+  > result (E e) noexcept : result { error_type { e } } { }
 
   result (::std::error_condition const& ec) :
-    valid { not ec }
-  {
-    if (*this) { ::new (::core::as_void(this->val)) value_type(); }
-    else { ::new (::core::as_void(this->cnd)) error_type(ec); }
-  }
-
-  result (value_type const& val) :
-    val(val),
-    valid { true }
+    base { ec ? base { impl::unexpect, ec } : base { impl::place } }
   { }
 
+  result (value_type const& val) : base { impl::place, val } { }
   result (value_type&& val) noexcept(nothrow) :
-    val(::core::move(val)),
-    valid { true }
+    base { impl::place, ::core::move(val) }
   { }
 
   template <
@@ -774,12 +1904,12 @@ struct result final {
       >()
     >
   > result (result<T> const& that) :
-    valid { that.valid }
-  {
-    if (*this) { ::new (::core::as_void(this->val)) value_type(that.val); }
-    else { ::new (::core::as_void(this->cnd)) error_type(that.cnd); }
-  }
-
+    base {
+      that
+        ? base { impl::place, that.val }
+        : base { impl::unexpect, that.err }
+    }
+  { }
 
   template <
     class T,
@@ -790,19 +1920,18 @@ struct result final {
       >()
     >
   > result (result<T>&& that) :
-    valid { that.valid }
-  {
-    if (*this) {
-      ::new (::core::as_void(this->val)) value_type(::core::move(that.val));
-    } else { ::new (::core::as_void(this->cnd)) error_type(that.cnd); }
-  }
+    base {
+      that
+        ? base { impl::place, ::core::move(that.val) }
+        : base { impl::unexpect, that.err }
+    }
+  { }
 
   template <
     class... Args,
     class=enable_if_t<::std::is_constructible<value_type, Args...>::value>
   > explicit result (in_place_t, Args&&... args) :
-    val(::core::forward<Args>(args)...),
-    valid { true }
+    base { impl::place, ::core::forward<Args>(args)... }
   { }
 
   template <
@@ -819,44 +1948,15 @@ struct result final {
     in_place_t,
     ::std::initializer_list<T> il,
     Args&&... args
-  ) : val(il, ::core::forward<Args>(args)...), valid { true } { }
-
-  result (result const& that) :
-    valid { that.valid }
-  {
-    if (*this) { ::new (::core::as_void(this->val)) value_type(that.val); }
-    else { ::new (::core::as_void(this->cnd)) error_type(that.cnd); }
-  }
-
-  result (result&& that) :
-    valid { that.valid }
-  {
-    if (*this) {
-      ::new (::core::as_void(this->val)) value_type(::core::move(that.val));
-    } else { ::new (::core::as_void(this->cnd)) error_type(that.cnd); }
-  }
-
-  result () :
-    val { },
-    valid { true }
-  { }
-
-  ~result () noexcept { this->reset(); }
+  ) : base { impl::place, il, ::core::forward<Args>(args)... } { }
 
-  result& operator = (result const& that) {
-    result { that }.swap(*this);
-    return *this;
-  }
+  result (result const&) = default;
+  result (result&&) = default;
+  result () : base { impl::place } { }
+  ~result () = default;
 
-  result& operator = (result&& that) noexcept(
-    meta::all<
-      ::std::is_nothrow_move_assignable<value_type>::value,
-      ::std::is_nothrow_move_constructible<value_type>::value
-    >()
-  ) {
-    result { ::core::move(that) }.swap(*this);
-    return *this;
-  }
+  result& operator = (result const&) = default;
+  result& operator = (result&&) = default;
 
   template <
     class T,
@@ -899,10 +1999,10 @@ struct result final {
 
   result& operator = (::std::error_condition const& cnd) {
     if (not cnd) { return *this; }
-    if (not *this) { this->cnd = cnd; }
+    if (not *this) { this->err = cnd; }
     else {
       this->reset();
-      ::new (::core::as_void(this->cnd)) error_type(cnd);
+      ::new (::core::as_void(this->err)) error_type(cnd);
       this->valid = false;
     }
     return *this;
@@ -914,22 +2014,7 @@ struct result final {
       ::std::is_nothrow_move_constructible<value_type>::value
     >()
   ) {
-    using ::std::swap;
-    if (not *this and not that) {
-      swap(this->cnd, that.cnd);
-      return;
-    }
-
-    if (*this and that) {
-      swap(this->val, that.val);
-      return;
-    }
-
-    auto& to_invalidate = *this ? *this : that;
-    auto& to_validate = *this ? that : *this;
-    auto cnd = to_validate.cnd;
-    to_validate.emplace(::core::move(*to_invalidate));
-    to_invalidate = cnd;
+    base::swap(that);
   }
 
   explicit operator bool () const noexcept { return this->valid; }
@@ -964,12 +2049,12 @@ struct result final {
 
   value_type const& value () const noexcept(false) {
     if (*this) { return **this; }
-    throw_system_error(this->cnd);
+    throw_system_error(this->err);
   }
 
   value_type& value () noexcept(false) {
     if (*this) { return **this; }
-   throw_system_error(this->cnd);
+   throw_system_error(this->err);
   }
 
   template <
@@ -998,21 +2083,72 @@ struct result final {
       : static_cast<value_type>(::core::forward<T>(val));
   }
 
+  template <class F>
+  auto map (F&& f) const& -> result<
+    decay_t<invoke_of_t<F, value_type const&>>
+  > {
+    if (not *this) { return { impl::unexpect, this->err }; }
+    return ::core::invoke(::core::forward<F>(f), **this);
+  }
+
+  template <class F>
+  auto map (F&& f) & -> result<
+    decay_t<invoke_of_t<F, value_type&>>
+  > {
+    if (not *this) { return { impl::unexpect, this->err }; }
+    return ::core::invoke(::core::forward<F>(f), **this);
+  }
+
+  template <class F>
+  auto map (F&& f) && -> result<
+    decay_t<invoke_of_t<F, value_type&&>>
+  > {
+    if (not *this) { return { impl::unexpect, this->err }; }
+    return ::core::invoke(::core::forward<F>(f), ::core::move(**this));
+  }
+
+  template <class F>
+  auto and_then (F&& f) const& -> decay_t<invoke_of_t<F, value_type const&>> {
+    if (not *this) { return { impl::unexpect, this->err }; }
+    return ::core::invoke(::core::forward<F>(f), **this);
+  }
+
+  template <class F>
+  auto and_then (F&& f) & -> decay_t<invoke_of_t<F, value_type&>> {
+    if (not *this) { return { impl::unexpect, this->err }; }
+    return ::core::invoke(::core::forward<F>(f), **this);
+  }
+
+  template <class F>
+  auto and_then (F&& f) && -> decay_t<invoke_of_t<F, value_type&&>> {
+    if (not *this) { return { impl::unexpect, this->err }; }
+    return ::core::invoke(::core::forward<F>(f), ::core::move(**this));
+  }
+
+  template <class F>
+  result or_else (F&& f) const& {
+    if (*this) { return *this; }
+    return ::core::invoke(::core::forward<F>(f), this->err);
+  }
+
+  template <class F>
+  result or_else (F&& f) && {
+    if (*this) { return ::core::move(*this); }
+    return ::core::invoke(::core::forward<F>(f), this->err);
+  }
+
   ::std::error_condition const& condition () const noexcept(false) {
     if (*this) { throw_bad_result_condition(); }
-    return this->cnd;
+    return this->err;
   }
 
 private:
-  void reset () {
-    *this ? this->val.~value_type() : this->cnd.~error_condition();
-  }
-
-  union {
-    value_type val;
-    error_type cnd;
-  };
-  bool valid { false };
+  /* used by map and and_then to forward an error to a result<U> without
+   * requiring U to be default constructible
+   */
+  result (impl::unexpect_t, error_type const& ec) noexcept :
+    base { impl::unexpect, ec }
+  { }
 };
 
 #ifndef CORE_NO_EXCEPTIONS
@@ -1065,6 +2201,218 @@ private:
 };
 #endif /* CORE_NO_EXCEPTIONS */
 
+template <class Error>
+struct expected<void, Error> final {
+  using value_type = void;
+  using error_type = Error;
+
+  static_assert(
+    ::std::is_object<error_type>::value,
+    "Cannot have expected with non-object error type (undefined behavior)"
+  );
+
+  static_assert(
+    ::std::is_nothrow_destructible<error_type>::value,
+    "Cannot have expected with throwable error destructor (undefined behavior)"
+  );
+
+#ifdef CORE_NO_EXCEPTIONS
+  static_assert(
+    not ::std::is_same<error_type, ::std::exception_ptr>::value,
+    "Cannot have expected<T, std::exception_ptr> without exceptions"
+  );
+#endif /* CORE_NO_EXCEPTIONS */
+
+  expected (unexpected<error_type> const& e) :
+    err(e.value()),
+    valid { false }
+  { }
+
+  expected (unexpected<error_type>&& e) noexcept(
+    ::std::is_nothrow_move_constructible<error_type>::value
+  ) :
+    err(::core::move(e).value()),
+    valid { false }
+  { }
+
+  expected (expected const& that) :
+    valid { that.valid }
+  {
+    if (*this) { return; }
+    ::new (::core::as_void(this->err)) error_type(that.err);
+  }
+
+  expected (expected&& that) noexcept(
+    ::std::is_nothrow_move_constructible<error_type>::value
+  ) : valid { that.valid } {
+    if (*this) { return; }
+    ::new (::core::as_void(this->err)) error_type(::core::move(that.err));
+  }
+
+  expected () noexcept : dummy { }, valid { true } { }
+  ~expected () noexcept { if (not *this) { this->err.~error_type(); } }
+
+  expected& operator = (unexpected<error_type> const& e) {
+    expected { e }.swap(*this);
+    return *this;
+  }
+
+  expected& operator = (unexpected<error_type>&& e) {
+    expected { ::core::move(e) }.swap(*this);
+    return *this;
+  }
+
+  expected& operator = (expected const& that) {
+    expected { that }.swap(*this);
+    return *this;
+  }
+
+  expected& operator = (expected&& that) noexcept(
+    ::std::is_nothrow_move_constructible<error_type>::value
+  ) {
+    expected { ::core::move(that) }.swap(*this);
+    return *this;
+  }
+
+  void swap (expected& that) noexcept(
+    meta::all<
+      ::std::is_nothrow_move_constructible<error_type>::value,
+      is_nothrow_swappable<error_type>::value
+    >()
+  ) {
+    using ::std::swap;
+    if (*this and that) { return; }
+    if (not *this and not that) {
+      swap(this->err, that.err);
+      return;
+    }
+
+    auto& to_invalidate = *this ? *this : that;
+    auto& to_validate = *this ? that : *this;
+    ::new (::core::as_void(to_invalidate.err)) error_type(
+      ::core::move(to_validate.err)
+    );
+    to_validate.err.~error_type();
+    to_validate.valid = true;
+    to_invalidate.valid = false;
+  }
+
+  explicit operator bool () const noexcept { return this->valid; }
+
+  error_type const& error () const noexcept(false) {
+    if (*this) { throw_bad_expected_type("expected<void, E> is valid"); }
+    return this->err;
+  }
+
+  error_type& error () noexcept(false) {
+    if (*this) { throw_bad_expected_type("expected<void, E> is valid"); }
+    return this->err;
+  }
+
+private:
+  union {
+    ::std::uint8_t dummy;
+    error_type err;
+  };
+  bool valid { true };
+};
+
+template <class T, class E>
+auto operator == (
+  expected<T, E> const& lhs,
+  expected<T, E> const& rhs
+) -> impl::error_comparison_t<E> {
+  if (lhs and rhs) { return *lhs == *rhs; }
+  if (not lhs and not rhs) { return lhs.error() == rhs.error(); }
+  return false;
+}
+
+template <class E>
+auto operator == (
+  expected<void, E> const& lhs,
+  expected<void, E> const& rhs
+) -> impl::error_comparison_t<E> {
+  if (not lhs and not rhs) { return lhs.error() == rhs.error(); }
+  return static_cast<bool>(lhs) == static_cast<bool>(rhs);
+}
+
+template <class T, class E>
+auto operator == (
+  expected<T, E> const& lhs,
+  unexpected<E> const& rhs
+) -> impl::error_comparison_t<E> {
+  return not lhs and lhs.error() == rhs.value();
+}
+
+template <class T, class E>
+auto operator == (
+  unexpected<E> const& lhs,
+  expected<T, E> const& rhs
+) -> impl::error_comparison_t<E> {
+  return not rhs and lhs.value() == rhs.error();
+}
+
+template <class T, class E>
+auto operator == (
+  expected<T, E> const& lhs,
+  T const& rhs
+) -> impl::error_comparison_t<E> {
+  return lhs and *lhs == rhs;
+}
+
+template <class T, class E>
+auto operator == (
+  T const& lhs,
+  expected<T, E> const& rhs
+) -> impl::error_comparison_t<E> {
+  return rhs and lhs == *rhs;
+}
+
+template <class T, class E>
+auto operator != (
+  expected<T, E> const& lhs,
+  expected<T, E> const& rhs
+) -> impl::error_comparison_t<E> {
+  return not (lhs == rhs);
+}
+
+template <class T, class E>
+auto operator != (
+  expected<T, E> const& lhs,
+  unexpected<E> const& rhs
+) -> impl::error_comparison_t<E> {
+  return not (lhs == rhs);
+}
+
+template <class T, class E>
+auto operator != (
+  unexpected<E> const& lhs,
+  expected<T, E> const& rhs
+) -> impl::error_comparison_t<E> {
+  return not (lhs == rhs);
+}
+
+template <class T, class E>
+auto operator != (
+  expected<T, E> const& lhs,
+  T const& rhs
+) -> impl::error_comparison_t<E> {
+  return not (lhs == rhs);
+}
+
+template <class T, class E>
+auto operator != (
+  T const& lhs,
+  expected<T, E> const& rhs
+) -> impl::error_comparison_t<E> {
+  return not (lhs == rhs);
+}
+
+template <class T, class E>
+void swap (expected<T, E>& lhs, expected<T, E>& rhs) noexcept(
+  noexcept(lhs.swap(rhs))
+) { lhs.swap(rhs); }
+
 template <>
 struct result<void> final {
   using value_type = void;
@@ -1152,6 +2500,22 @@ constexpr bool operator == (T const& value, optional<T> const& opt) noexcept {
   return opt and value == *opt;
 }
 
+template <class T>
+constexpr bool operator == (
+  optional<T&> const& opt,
+  remove_cv_t<T> const& value
+) noexcept {
+  return opt and *opt == value;
+}
+
+template <class T>
+constexpr bool operator == (
+  remove_cv_t<T> const& value,
+  optional<T&> const& opt
+) noexcept {
+  return opt and value == *opt;
+}
+
 #ifndef CORE_NO_EXCEPTIONS
 template <class T>
 bool operator == (expected<T> const& lhs, expected<T> const& rhs) noexcept {
@@ -1364,6 +2728,22 @@ constexpr bool operator != (T const& value, optional<T> const& opt) noexcept {
   return not (value == opt);
 }
 
+template <class T>
+constexpr bool operator != (
+  optional<T&> const& opt,
+  remove_cv_t<T> const& value
+) noexcept {
+  return not (opt == value);
+}
+
+template <class T>
+constexpr bool operator != (
+  remove_cv_t<T> const& value,
+  optional<T&> const& opt
+) noexcept {
+  return not (value == opt);
+}
+
 #ifndef CORE_NO_EXCEPTIONS
 template <class T>
 bool operator != (expected<T> const& lhs, expected<T> const& rhs) noexcept {
@@ -1767,6 +3147,27 @@ struct hash<::core::v2::optional<Type>> {
   }
 };
 
+template <class Type>
+struct hash<::core::v2::optional<Type&>> {
+  using value_type = ::core::v2::remove_cv_t<Type>;
+  using result_type = typename hash<value_type>::result_type;
+  using argument_type = ::core::v2::optional<Type&>;
+
+  result_type operator () (argument_type const& value) const noexcept {
+    return value ? hash<value_type> { }(*value) : result_type { };
+  }
+};
+
+template <class Type, class Traits>
+struct hash<::core::v2::compact_optional<Type, Traits>> {
+  using result_type = typename hash<Type>::result_type;
+  using argument_type = ::core::v2::compact_optional<Type, Traits>;
+
+  result_type operator () (argument_type const& value) const noexcept {
+    return value ? hash<Type> { }(*value) : result_type { };
+  }
+};
+
 #ifndef CORE_NO_EXCEPTIONS
 template <class Type>
 struct hash<::core::v2::expected<Type>> {
@@ -1779,6 +3180,16 @@ struct hash<::core::v2::expected<Type>> {
 };
 #endif /* CORE_NO_EXCEPTIONS */
 
+template <>
+struct hash<::core::v2::status_code> {
+  using result_type = size_t;
+  using argument_type = ::core::v2::status_code;
+
+  result_type operator () (argument_type const& value) const noexcept {
+    return hash<argument_type::value_type> { }(value.bits());
+  }
+};
+
 template <class Type>
 struct hash<::core::v2::result<Type>> {
   using result_type = typename hash<Type>::result_type;
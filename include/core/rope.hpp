@@ -0,0 +1,493 @@
+#ifndef CORE_ROPE_HPP
+#define CORE_ROPE_HPP
+
+#include <core/memory_resource.hpp>
+#include <core/string_view.hpp>
+#include <core/type_traits.hpp>
+#include <core/range.hpp>
+
+#include <functional>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include <cstdint>
+#include <cstring>
+
+#if not defined(_WIN32)
+  #include <sys/uio.h>
+#endif /* not defined(_WIN32) */
+
+namespace core {
+inline namespace v2 {
+
+/* iterates the characters of a basic_rope, one segment after another */
+template <class CharT, class Traits=::std::char_traits<CharT>>
+struct rope_iterator final {
+  using iterator_category = ::std::forward_iterator_tag;
+  using value_type = CharT;
+  using difference_type = ::std::ptrdiff_t;
+  using reference = value_type const&;
+  using pointer = value_type const*;
+
+  using view_type = basic_string_view<CharT, Traits>;
+
+  rope_iterator (view_type const* segment, ::std::size_t offset) noexcept :
+    segment { segment },
+    offset { offset }
+  { }
+
+  rope_iterator () noexcept = default;
+
+  reference operator * () const noexcept {
+    return this->segment->data()[this->offset];
+  }
+
+  pointer operator -> () const noexcept {
+    return this->segment->data() + this->offset;
+  }
+
+  rope_iterator& operator ++ () noexcept {
+    if (++this->offset == this->segment->size()) {
+      ++this->segment;
+      this->offset = 0;
+    }
+    return *this;
+  }
+
+  rope_iterator operator ++ (int) noexcept {
+    auto copy = *this;
+    ++*this;
+    return copy;
+  }
+
+  bool operator == (rope_iterator const& that) const noexcept {
+    return this->segment == that.segment and this->offset == that.offset;
+  }
+
+  bool operator != (rope_iterator const& that) const noexcept {
+    return not (*this == that);
+  }
+
+private:
+  view_type const* segment { nullptr };
+  ::std::size_t offset { 0 };
+};
+
+/* a string made of a sequence of segments that are never flattened.
+ * Appending a view stores only the view, so its characters must outlive the
+ * rope. Appending a copy stores the characters in an arena owned by the rope,
+ * which is created from the rope's resource on first use. Segments that are
+ * adjacent in memory are merged as they are appended.
+ *
+ * A rope is movable, but not copyable, since other ropes may borrow the
+ * characters it owns.
+ */
+template <class CharT, class Traits=::std::char_traits<CharT>>
+struct basic_rope final {
+  using view_type = basic_string_view<CharT, Traits>;
+  using traits_type = Traits;
+  using value_type = CharT;
+  using size_type = ::std::size_t;
+  using difference_type = ::std::ptrdiff_t;
+
+  using const_iterator = rope_iterator<CharT, Traits>;
+  using iterator = const_iterator;
+
+  static constexpr size_type npos = view_type::npos;
+
+  explicit basic_rope (
+    pmr::memory_resource* upstream = pmr::get_default_resource()
+  ) : pieces { pmr::polymorphic_allocator<view_type> { upstream } } { }
+
+  basic_rope (basic_rope const&) = delete;
+
+  basic_rope (basic_rope&& that) noexcept :
+    pieces { ::core::move(that.pieces) },
+    arena { that.arena },
+    count { that.count }
+  {
+    that.pieces.clear();
+    that.arena = nullptr;
+    that.count = 0;
+  }
+
+  ~basic_rope () noexcept { this->destroy_arena(); }
+
+  basic_rope& operator = (basic_rope const&) = delete;
+
+  /* polymorphic allocators do not propagate, so segments can only be taken
+   * from that when both use the same resource. Otherwise the characters are
+   * copied into this rope's arena, and that keeps its own arena until it is
+   * cleared or destroyed.
+   */
+  basic_rope& operator = (basic_rope&& that) {
+    if (this == &that) { return *this; }
+    if (this->pieces.get_allocator() != that.pieces.get_allocator()) {
+      basic_rope copy { this->resource() };
+      for (auto piece : that.pieces) { copy.append_copy(piece); }
+      that.pieces.clear();
+      that.count = 0;
+      return *this = ::core::move(copy);
+    }
+    this->destroy_arena();
+    this->pieces = ::core::move(that.pieces);
+    this->arena = that.arena;
+    this->count = that.count;
+    that.pieces.clear();
+    that.arena = nullptr;
+    that.count = 0;
+    return *this;
+  }
+
+  pmr::memory_resource* resource () const noexcept {
+    return this->pieces.get_allocator().resource();
+  }
+
+  /* stores str without copying it */
+  basic_rope& append (view_type str) {
+    if (str.empty()) { return *this; }
+    if (not this->pieces.empty()) {
+      auto& last = this->pieces.back();
+      if (last.data() + last.size() == str.data()) {
+        last = view_type { last.data(), last.size() + str.size() };
+        this->count += str.size();
+        return *this;
+      }
+    }
+    this->pieces.push_back(str);
+    this->count += str.size();
+    return *this;
+  }
+
+  /* borrows the segments of that, including those it owns */
+  basic_rope& append (basic_rope const& that) {
+    auto const size = that.pieces.size();
+    this->pieces.reserve(this->pieces.size() + size);
+    for (size_type idx = 0; idx < size; ++idx) {
+      this->append(that.pieces[idx]);
+    }
+    return *this;
+  }
+
+  /* copies str into the rope's arena */
+  basic_rope& append_copy (view_type str) {
+    if (str.empty()) { return *this; }
+    if (not this->arena) { this->create_arena(); }
+    auto const memory = static_cast<CharT*>(
+      this->arena->allocate(str.size() * sizeof(CharT), alignof(CharT))
+    );
+    Traits::copy(memory, str.data(), str.size());
+    return this->append(view_type { memory, str.size() });
+  }
+
+  void reserve (size_type segments) { this->pieces.reserve(segments); }
+
+  /* forgets every segment, and returns the memory held by the arena */
+  void clear () noexcept {
+    this->pieces.clear();
+    this->count = 0;
+    if (this->arena) { this->arena->release(); }
+  }
+
+  range<view_type const*> segments () const noexcept {
+    auto const data = this->pieces.data();
+    return make_range(data, data + this->pieces.size());
+  }
+
+  const_iterator cbegin () const noexcept {
+    return const_iterator { this->pieces.data(), 0 };
+  }
+
+  const_iterator cend () const noexcept {
+    return const_iterator { this->pieces.data() + this->pieces.size(), 0 };
+  }
+
+  const_iterator begin () const noexcept { return this->cbegin(); }
+  const_iterator end () const noexcept { return this->cend(); }
+
+  size_type length () const noexcept { return this->size(); }
+  size_type size () const noexcept { return this->count; }
+  bool empty () const noexcept { return not this->count; }
+
+  /* copies at most n characters starting at pos into s, like
+   * basic_string_view::copy
+   */
+  size_type copy (CharT* s, size_type n, size_type pos=0) const {
+    if (pos > this->size()) {
+      throw_out_of_range("start position out of range");
+    }
+    n = ::std::min(n, this->size() - pos);
+    auto remaining = n;
+    for (auto piece : this->pieces) {
+      if (not remaining) { break; }
+      if (pos >= piece.size()) {
+        pos -= piece.size();
+        continue;
+      }
+      auto const written = piece.copy(s, remaining, pos);
+      s += written;
+      remaining -= written;
+      pos = 0;
+    }
+    return n;
+  }
+
+  template <class A=::std::allocator<CharT>>
+  ::std::basic_string<CharT, Traits, A> to_string (
+    A const& allocator=A()
+  ) const {
+    ::std::basic_string<CharT, Traits, A> result { allocator };
+    result.reserve(this->size());
+    for (auto piece : this->pieces) {
+      result.append(piece.data(), piece.size());
+    }
+    return result;
+  }
+
+  size_type find (view_type str, size_type pos=0) const noexcept {
+    if (str.empty()) { return pos <= this->size() ? pos : npos; }
+    auto const size = this->pieces.size();
+    size_type base = 0;
+    size_type idx = 0;
+    while (idx < size and base + this->pieces[idx].size() <= pos) {
+      base += this->pieces[idx++].size();
+    }
+    for (; idx < size; base += this->pieces[idx++].size()) {
+      auto const piece = this->pieces[idx];
+      auto const offset = pos > base ? pos - base : 0;
+      auto const found = piece.find(str, offset);
+      if (found != npos) { return base + found; }
+      /* only matches that cross into the following segments remain */
+      auto start = piece.size() >= str.size()
+        ? ::std::max(offset, piece.size() - str.size() + 1)
+        : offset;
+      for (; start < piece.size(); ++start) {
+        if (this->matches(idx, start, str)) { return base + start; }
+      }
+    }
+    return npos;
+  }
+
+  size_type find (value_type ch, size_type pos=0) const noexcept {
+    size_type base = 0;
+    for (auto piece : this->pieces) {
+      if (base + piece.size() > pos) {
+        auto const found = piece.find(ch, pos > base ? pos - base : 0);
+        if (found != npos) { return base + found; }
+      }
+      base += piece.size();
+    }
+    return npos;
+  }
+
+  bool equal (view_type that) const noexcept {
+    if (that.size() != this->size()) { return false; }
+    for (auto piece : this->pieces) {
+      if (Traits::compare(piece.data(), that.data(), piece.size())) {
+        return false;
+      }
+      that.remove_prefix(piece.size());
+    }
+    return true;
+  }
+
+  bool equal (basic_rope const& that) const noexcept {
+    if (that.size() != this->size()) { return false; }
+    auto lhs = this->pieces.begin();
+    auto rhs = that.pieces.begin();
+    view_type left;
+    view_type right;
+    while (true) {
+      if (left.empty()) {
+        if (lhs == this->pieces.end()) { return true; }
+        left = *lhs++;
+      }
+      if (right.empty()) { right = *rhs++; }
+      auto const n = ::std::min(left.size(), right.size());
+      if (Traits::compare(left.data(), right.data(), n)) { return false; }
+      left.remove_prefix(n);
+      right.remove_prefix(n);
+    }
+  }
+
+#if not defined(_WIN32)
+  /* fills out with up to n of the segments, starting at segment first, for
+   * use with writev or sendmsg. Returns how many were written. Callers are
+   * expected to respect IOV_MAX.
+   */
+  size_type to_iovec (
+    ::iovec* out,
+    size_type n,
+    size_type first=0
+  ) const noexcept {
+    auto const size = this->pieces.size();
+    if (first >= size) { return 0; }
+    n = ::std::min(n, size - first);
+    for (size_type idx = 0; idx < n; ++idx) {
+      auto const piece = this->pieces[first + idx];
+      out[idx].iov_base = const_cast<CharT*>(piece.data());
+      out[idx].iov_len = piece.size() * sizeof(CharT);
+    }
+    return n;
+  }
+#endif /* not defined(_WIN32) */
+
+  void swap (basic_rope& that) {
+    if (this->pieces.get_allocator() != that.pieces.get_allocator()) {
+      basic_rope temp { that.resource() };
+      temp = ::core::move(*this);
+      *this = ::core::move(that);
+      that = ::core::move(temp);
+      return;
+    }
+    using ::std::swap;
+    swap(this->pieces, that.pieces);
+    swap(this->arena, that.arena);
+    swap(this->count, that.count);
+  }
+
+private:
+  using arena_type = pmr::monotonic_buffer_resource;
+
+  /* whether str occurs at offset within segment idx, continuing into the
+   * segments after it
+   */
+  bool matches (size_type idx, size_type offset, view_type str) const noexcept {
+    for (; idx < this->pieces.size() and not str.empty(); ++idx, offset = 0) {
+      auto const piece = this->pieces[idx];
+      auto const n = ::std::min(piece.size() - offset, str.size());
+      if (Traits::compare(piece.data() + offset, str.data(), n)) {
+        return false;
+      }
+      str.remove_prefix(n);
+    }
+    return str.empty();
+  }
+
+  void create_arena () {
+    pmr::polymorphic_allocator<arena_type> allocator { this->resource() };
+    auto const memory = allocator.allocate(1);
+    this->arena = ::new (memory) arena_type { this->resource() };
+  }
+
+  /* the arena is returned to the resource it was created from, which it
+   * records as its upstream
+   */
+  void destroy_arena () noexcept {
+    if (not this->arena) { return; }
+    pmr::polymorphic_allocator<arena_type> allocator {
+      this->arena->upstream_resource()
+    };
+    this->arena->~arena_type();
+    allocator.deallocate(this->arena, 1);
+    this->arena = nullptr;
+  }
+
+  ::std::vector<view_type, pmr::polymorphic_allocator<view_type>> pieces;
+  arena_type* arena { nullptr };
+  size_type count { 0 };
+};
+
+template <class CharT, class Traits>
+constexpr typename basic_rope<CharT, Traits>::size_type
+basic_rope<CharT, Traits>::npos;
+
+using u32rope = basic_rope<char32_t>;
+using u16rope = basic_rope<char16_t>;
+using wrope = basic_rope<wchar_t>;
+using rope = basic_rope<char>;
+
+template <class CharT, class Traits>
+bool operator == (
+  basic_rope<CharT, Traits> const& lhs,
+  basic_rope<CharT, Traits> const& rhs
+) noexcept { return lhs.equal(rhs); }
+
+template <class CharT, class Traits>
+bool operator != (
+  basic_rope<CharT, Traits> const& lhs,
+  basic_rope<CharT, Traits> const& rhs
+) noexcept { return not lhs.equal(rhs); }
+
+template <class CharT, class Traits>
+bool operator == (
+  basic_rope<CharT, Traits> const& lhs,
+  identity_t<basic_string_view<CharT, Traits>> rhs
+) noexcept { return lhs.equal(rhs); }
+
+template <class CharT, class Traits>
+bool operator != (
+  basic_rope<CharT, Traits> const& lhs,
+  identity_t<basic_string_view<CharT, Traits>> rhs
+) noexcept { return not lhs.equal(rhs); }
+
+template <class CharT, class Traits>
+bool operator == (
+  identity_t<basic_string_view<CharT, Traits>> lhs,
+  basic_rope<CharT, Traits> const& rhs
+) noexcept { return rhs.equal(lhs); }
+
+template <class CharT, class Traits>
+bool operator != (
+  identity_t<basic_string_view<CharT, Traits>> lhs,
+  basic_rope<CharT, Traits> const& rhs
+) noexcept { return not rhs.equal(lhs); }
+
+template <class CharT, class Traits>
+void swap (
+  basic_rope<CharT, Traits>& lhs,
+  basic_rope<CharT, Traits>& rhs
+) { lhs.swap(rhs); }
+
+}} /* namespace core::v2 */
+
+namespace std {
+
+/* hashes the characters in blocks of 1024 bytes, chaining each block's hash
+ * into the seed of the next, so that the result does not depend on how the
+ * rope is segmented. Ropes of up to one block hash like their string_view.
+ */
+template <class CharT, class Traits>
+struct hash<core::v2::basic_rope<CharT, Traits>> {
+  using argument_type = core::v2::basic_rope<CharT, Traits>;
+  using result_type = size_t;
+
+  result_type operator ()(argument_type const& rope) const noexcept {
+    constexpr size_t block = 1024;
+    core::v2::impl::wyhash const hasher { };
+    auto const segments = rope.segments();
+    auto const bytes = rope.size() * sizeof(CharT);
+    if (segments.size() == 1 and bytes <= block) {
+      auto const& piece = segments.front();
+      return static_cast<result_type>(
+        hasher(piece.data(), bytes, 0)
+      );
+    }
+    unsigned char buffer[block];
+    uint64_t seed = 0;
+    size_t used = 0;
+    auto remaining = bytes;
+    for (auto const& piece : segments) {
+      auto bytes = reinterpret_cast<unsigned char const*>(piece.data());
+      auto length = piece.size() * sizeof(CharT);
+      while (length) {
+        auto const n = min(length, block - used);
+        memcpy(buffer + used, bytes, n);
+        used += n;
+        bytes += n;
+        length -= n;
+        remaining -= n;
+        if (used == block and remaining) {
+          seed = hasher(buffer, block, seed);
+          used = 0;
+        }
+      }
+    }
+    return static_cast<result_type>(hasher(buffer, used, seed));
+  }
+};
+
+} /* namespace std */
+
+#endif /* CORE_ROPE_HPP */
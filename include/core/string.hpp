@@ -11,12 +11,12 @@ inline namespace v2 {
 
 template <class CharT, class Traits, class A, class Predicate>
 void erase_if (::std::basic_string<CharT, Traits, A>& str, Predicate pred) {
-  s.erase(::core::remove_if(str, pred), ::std::end(str));
+  str.erase(::core::remove_if(str, pred), ::std::end(str));
 }
 
 template <class CharT, class Traits, class A, class U>
 void erase (::std::basic_string<CharT, Traits, A>& str, U const& value) {
-  s.erase(::core::remove(str, value), ::std::end(str));
+  str.erase(::core::remove(str, value), ::std::end(str));
 }
 
 }} /* namespace core::v2 */
@@ -7,11 +7,48 @@
 #include <algorithm>
 #include <iterator>
 #include <string>
+#include <vector>
 #include <limits>
 
 #include <cstdlib>
+#include <cstring>
+#include <cstdint>
 #include <ciso646>
 
+#include <core/utility.hpp>
+#include <core/range.hpp>
+
+#if not defined(CORE_NO_SIMD) and (defined(__SSE2__) or defined(_M_X64))
+  #define CORE_STRING_VIEW_SSE2
+  #include <emmintrin.h>
+#endif /* SSE2 */
+
+/* The AVX2 paths are compiled with __attribute__((target("avx2"))) and are
+ * only called once __builtin_cpu_supports has reported AVX2 at runtime (see
+ * has_avx2). This runtime dispatch is what makes it safe to emit them into a
+ * build that only targets SSE2. Both builtins first appear together in GCC
+ * 4.9 and clang 3.8. Define CORE_NO_AVX2 to leave the AVX2 paths out.
+ */
+#if defined(CORE_STRING_VIEW_SSE2) and not defined(CORE_NO_AVX2)
+  #if defined(__clang__)
+    #if __clang_major__ > 3 or (__clang_major__ == 3 and __clang_minor__ >= 8)
+      #define CORE_STRING_VIEW_AVX2
+    #endif /* clang 3.8 */
+  #elif defined(__GNUC__)
+    #if __GNUC__ > 4 or (__GNUC__ == 4 and __GNUC_MINOR__ >= 9)
+      #define CORE_STRING_VIEW_AVX2
+    #endif /* GCC 4.9 */
+  #endif /* defined(__clang__) */
+#endif /* defined(CORE_STRING_VIEW_SSE2) and not defined(CORE_NO_AVX2) */
+
+#if defined(CORE_STRING_VIEW_AVX2)
+  #include <immintrin.h>
+#endif /* defined(CORE_STRING_VIEW_AVX2) */
+
+#if defined(CORE_STRING_VIEW_SSE2) and defined(_MSC_VER)
+  #include <intrin.h>
+#endif /* defined(CORE_STRING_VIEW_SSE2) and defined(_MSC_VER) */
+
 #if defined(_MSC_VER)
   #pragma warning(push)
   #pragma warning(disable:5030)
@@ -22,7 +59,26 @@ namespace core {
 inline namespace v2 {
 namespace impl {
 
-/* implementations of MurmurHash2 *Endian Neutral* (but not alignment!) */
+/* unaligned little endian word loads. memcpy compiles to a single load */
+inline ::std::uint64_t load64 (::std::uint8_t const* p) noexcept {
+  ::std::uint64_t value;
+  ::std::memcpy(&value, p, sizeof(value));
+#if defined(__BYTE_ORDER__) and __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+  value = __builtin_bswap64(value);
+#endif /* big endian */
+  return value;
+}
+
+inline ::std::uint32_t load32 (::std::uint8_t const* p) noexcept {
+  ::std::uint32_t value;
+  ::std::memcpy(&value, p, sizeof(value));
+#if defined(__BYTE_ORDER__) and __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+  value = __builtin_bswap32(value);
+#endif /* big endian */
+  return value;
+}
+
+/* implementations of MurmurHash2 *Endian Neutral* */
 template <::std::size_t=sizeof(::std::size_t)> struct murmur;
 template <> struct murmur<4> {
   constexpr murmur () = default;
@@ -35,10 +91,7 @@ template <> struct murmur<4> {
     auto data = static_cast<::std::uint8_t const*>(p);
 
     while (len >= sizeof(::std::uint32_t)) {
-      ::std::uint32_t mix = data[0];
-      mix |= ::std::uint32_t(data[1]) <<  8;
-      mix |= ::std::uint32_t(data[2]) << 16;
-      mix |= ::std::uint32_t(data[3]) << 24;
+      auto mix = load32(data);
 
       mix *= magic;
       mix ^= mix >> shift;
@@ -78,14 +131,7 @@ template <> struct murmur<8> {
     auto data = static_cast<::std::uint8_t const*>(p);
 
     while (len >= sizeof(::std::uint64_t)) {
-      ::std::uint64_t mix = data[0];
-      mix |= ::std::uint64_t(data[1]) <<  8;
-      mix |= ::std::uint64_t(data[2]) << 16;
-      mix |= ::std::uint64_t(data[3]) << 24;
-      mix |= ::std::uint64_t(data[4]) << 32;
-      mix |= ::std::uint64_t(data[5]) << 40;
-      mix |= ::std::uint64_t(data[6]) << 48;
-      mix |= ::std::uint64_t(data[7]) << 54;
+      auto mix = load64(data);
 
       mix *= magic;
       mix ^= mix >> shift;
@@ -117,6 +163,723 @@ template <> struct murmur<8> {
   }
 };
 
+/* follows wyhash (final version 4). It reads the input in 8 byte words, 48
+ * bytes per iteration for long inputs, and mixes with a 64x64 -> 128 bit
+ * multiply.
+ */
+inline void multiply (::std::uint64_t& lo, ::std::uint64_t& hi) noexcept {
+#if defined(__SIZEOF_INT128__)
+  __extension__ typedef unsigned __int128 uint128;
+  auto const product = uint128 { lo } * hi;
+  lo = static_cast<::std::uint64_t>(product);
+  hi = static_cast<::std::uint64_t>(product >> 64);
+#elif defined(_MSC_VER) and defined(_M_X64)
+  lo = _umul128(lo, hi, &hi);
+#else
+  auto const ll = (lo & 0xFFFFFFFF) * (hi & 0xFFFFFFFF);
+  auto const lh = (lo & 0xFFFFFFFF) * (hi >> 32);
+  auto const hl = (lo >> 32) * (hi & 0xFFFFFFFF);
+  auto const hh = (lo >> 32) * (hi >> 32);
+  auto const mid = (ll >> 32) + (lh & 0xFFFFFFFF) + (hl & 0xFFFFFFFF);
+  lo = (mid << 32) | (ll & 0xFFFFFFFF);
+  hi = hh + (lh >> 32) + (hl >> 32) + (mid >> 32);
+#endif /* defined(__SIZEOF_INT128__) */
+}
+
+inline ::std::uint64_t mix (::std::uint64_t lo, ::std::uint64_t hi) noexcept {
+  multiply(lo, hi);
+  return lo ^ hi;
+}
+
+constexpr ::std::uint64_t wyhash_secret0 = UINT64_C(0x2D358DCCAA6C78A5);
+constexpr ::std::uint64_t wyhash_secret1 = UINT64_C(0x8BB84B93962EACC9);
+constexpr ::std::uint64_t wyhash_secret2 = UINT64_C(0x4B33A62ED433D4A3);
+constexpr ::std::uint64_t wyhash_secret3 = UINT64_C(0x4D5A2DA51DE1AA47);
+
+struct wyhash final {
+  ::std::uint64_t operator () (
+    void const* ptr,
+    ::std::size_t len,
+    ::std::uint64_t seed
+  ) const noexcept {
+    auto p = static_cast<::std::uint8_t const*>(ptr);
+    seed ^= mix(seed ^ wyhash_secret0, wyhash_secret1);
+    ::std::uint64_t a = 0;
+    ::std::uint64_t b = 0;
+    if (len <= 16) {
+      if (len >= 4) {
+        auto const offset = (len >> 3) << 2;
+        a = ::std::uint64_t { load32(p) } << 32 | load32(p + offset);
+        b = ::std::uint64_t { load32(p + len - 4) } << 32 |
+          load32(p + len - 4 - offset);
+      } else if (len) {
+        a = ::std::uint64_t { p[0] } << 16 |
+          ::std::uint64_t { p[len >> 1] } << 8 |
+          p[len - 1];
+      }
+    } else {
+      auto remaining = len;
+      if (remaining > 48) {
+        auto see1 = seed;
+        auto see2 = seed;
+        do {
+          seed = mix(load64(p) ^ wyhash_secret1, load64(p + 8) ^ seed);
+          see1 = mix(load64(p + 16) ^ wyhash_secret2, load64(p + 24) ^ see1);
+          see2 = mix(load64(p + 32) ^ wyhash_secret3, load64(p + 40) ^ see2);
+          p += 48;
+          remaining -= 48;
+        } while (remaining > 48);
+        seed ^= see1 ^ see2;
+      }
+      while (remaining > 16) {
+        seed = mix(load64(p) ^ wyhash_secret1, load64(p + 8) ^ seed);
+        p += 16;
+        remaining -= 16;
+      }
+      a = load64(p + remaining - 16);
+      b = load64(p + remaining - 8);
+    }
+    a ^= wyhash_secret1;
+    b ^= seed;
+    multiply(a, b);
+    return mix(a ^ wyhash_secret0 ^ len, b ^ wyhash_secret1);
+  }
+};
+
+/* a constexpr mirror of wyhash for char, so that keys hashed at compile
+ * time match those hashed at runtime. Each loop becomes a recursion and the
+ * 128-bit multiply is split into 32-bit halves.
+ */
+constexpr ::std::uint64_t constant_byte (
+  char const* p,
+  ::std::size_t idx
+) noexcept { return static_cast<unsigned char>(p[idx]); }
+
+constexpr ::std::uint64_t constant_load32 (char const* p) noexcept {
+  return constant_byte(p, 0) |
+    constant_byte(p, 1) << 8 |
+    constant_byte(p, 2) << 16 |
+    constant_byte(p, 3) << 24;
+}
+
+constexpr ::std::uint64_t constant_load64 (char const* p) noexcept {
+  return constant_load32(p) | constant_load32(p + 4) << 32;
+}
+
+constexpr ::std::uint64_t constant_carry (
+  ::std::uint64_t a,
+  ::std::uint64_t b
+) noexcept {
+  return (((a & 0xFFFFFFFF) * (b & 0xFFFFFFFF)) >> 32) +
+    (((a & 0xFFFFFFFF) * (b >> 32)) & 0xFFFFFFFF) +
+    (((a >> 32) * (b & 0xFFFFFFFF)) & 0xFFFFFFFF);
+}
+
+constexpr ::std::uint64_t constant_high (
+  ::std::uint64_t a,
+  ::std::uint64_t b
+) noexcept {
+  return (a >> 32) * (b >> 32) +
+    (((a & 0xFFFFFFFF) * (b >> 32)) >> 32) +
+    (((a >> 32) * (b & 0xFFFFFFFF)) >> 32) +
+    (constant_carry(a, b) >> 32);
+}
+
+constexpr ::std::uint64_t constant_mix (
+  ::std::uint64_t a,
+  ::std::uint64_t b
+) noexcept { return (a * b) ^ constant_high(a, b); }
+
+constexpr ::std::uint64_t constant_final (
+  ::std::uint64_t a,
+  ::std::uint64_t b,
+  ::std::size_t len
+) noexcept {
+  return constant_mix(
+    (a * b) ^ wyhash_secret0 ^ len,
+    constant_high(a, b) ^ wyhash_secret1
+  );
+}
+
+constexpr ::std::uint64_t constant_short (
+  char const* p,
+  ::std::size_t len,
+  ::std::size_t offset,
+  ::std::uint64_t seed
+) noexcept {
+  return len >= 4
+    ? constant_final(
+        (constant_load32(p) << 32 | constant_load32(p + offset)) ^
+          wyhash_secret1,
+        (constant_load32(p + len - 4) << 32 |
+          constant_load32(p + len - 4 - offset)) ^ seed,
+        len)
+    : constant_final(
+        (len
+          ? constant_byte(p, 0) << 16 |
+            constant_byte(p, len >> 1) << 8 |
+            constant_byte(p, len - 1)
+          : 0) ^ wyhash_secret1,
+        seed,
+        len);
+}
+
+constexpr ::std::uint64_t constant_tail (
+  char const* p,
+  ::std::size_t remaining,
+  ::std::size_t len,
+  ::std::uint64_t seed
+) noexcept {
+  return remaining > 16
+    ? constant_tail(
+        p + 16,
+        remaining - 16,
+        len,
+        constant_mix(
+          constant_load64(p) ^ wyhash_secret1,
+          constant_load64(p + 8) ^ seed))
+    : constant_final(
+        constant_load64(p + remaining - 16) ^ wyhash_secret1,
+        constant_load64(p + remaining - 8) ^ seed,
+        len);
+}
+
+constexpr ::std::uint64_t constant_lanes (
+  char const* p,
+  ::std::size_t remaining,
+  ::std::size_t len,
+  ::std::uint64_t seed,
+  ::std::uint64_t see1,
+  ::std::uint64_t see2
+) noexcept {
+  return remaining > 48
+    ? constant_lanes(
+        p + 48,
+        remaining - 48,
+        len,
+        constant_mix(
+          constant_load64(p) ^ wyhash_secret1,
+          constant_load64(p + 8) ^ seed),
+        constant_mix(
+          constant_load64(p + 16) ^ wyhash_secret2,
+          constant_load64(p + 24) ^ see1),
+        constant_mix(
+          constant_load64(p + 32) ^ wyhash_secret3,
+          constant_load64(p + 40) ^ see2))
+    : constant_tail(p, remaining, len, seed ^ see1 ^ see2);
+}
+
+constexpr ::std::uint64_t constant_wyhash (
+  char const* p,
+  ::std::size_t len,
+  ::std::uint64_t seed
+) noexcept {
+  return len <= 16
+    ? constant_short(p, len, (len >> 3) << 2, seed)
+    : len > 48
+      ? constant_lanes(p, len, len, seed, seed, seed)
+      : constant_tail(p, len, len, seed);
+}
+
+constexpr ::std::size_t constant_length (
+  char const* str,
+  ::std::size_t max
+) noexcept { return max and *str ? 1 + constant_length(str + 1, max - 1) : 0; }
+
+/* substring search for char. Every function takes a haystack and a needle
+ * of 1 <= m <= n characters, and returns a pointer to the first (or last)
+ * match or nullptr. The vectorized searches compare the first and last
+ * character of the needle against a whole block of candidate positions at
+ * once, and only call memcmp for candidates where both match.
+ */
+inline char const* scalar_search (
+  char const* h,
+  ::std::size_t n,
+  char const* s,
+  ::std::size_t m
+) noexcept {
+  if (m > n) { return nullptr; }
+  auto const end = h + (n - m) + 1;
+  while (h != end) {
+    auto const distance = static_cast<::std::size_t>(end - h);
+    h = static_cast<char const*>(::std::memchr(h, s[0], distance));
+    if (not h) { return nullptr; }
+    if (::std::memcmp(h + 1, s + 1, m - 1) == 0) { return h; }
+    ++h;
+  }
+  return nullptr;
+}
+
+inline char const* scalar_reverse_search (
+  char const* h,
+  ::std::size_t n,
+  char const* s,
+  ::std::size_t m
+) noexcept {
+  if (m > n) { return nullptr; }
+  for (auto p = h + (n - m) + 1; p != h;) {
+    --p;
+    if (*p == s[0] and ::std::memcmp(p + 1, s + 1, m - 1) == 0) { return p; }
+  }
+  return nullptr;
+}
+
+#if defined(CORE_STRING_VIEW_SSE2)
+inline unsigned lowest_bit (unsigned mask) noexcept {
+#if defined(_MSC_VER)
+  unsigned long index;
+  _BitScanForward(&index, mask);
+  return static_cast<unsigned>(index);
+#else
+  return static_cast<unsigned>(__builtin_ctz(mask));
+#endif /* defined(_MSC_VER) */
+}
+
+inline unsigned highest_bit (unsigned mask) noexcept {
+#if defined(_MSC_VER)
+  unsigned long index;
+  _BitScanReverse(&index, mask);
+  return static_cast<unsigned>(index);
+#else
+  return 31u - static_cast<unsigned>(__builtin_clz(mask));
+#endif /* defined(_MSC_VER) */
+}
+
+/* the first and last characters are already known to match */
+inline bool inner_match (
+  char const* candidate,
+  char const* s,
+  ::std::size_t m
+) noexcept { return m < 3 or ::std::memcmp(candidate + 1, s + 1, m - 2) == 0; }
+
+inline unsigned sse2_candidates (
+  char const* block,
+  __m128i first,
+  __m128i last,
+  ::std::size_t m
+) noexcept {
+  auto const head = _mm_loadu_si128(reinterpret_cast<__m128i const*>(block));
+  auto const tail = _mm_loadu_si128(
+    reinterpret_cast<__m128i const*>(block + m - 1)
+  );
+  return static_cast<unsigned>(_mm_movemask_epi8(
+    _mm_and_si128(_mm_cmpeq_epi8(first, head), _mm_cmpeq_epi8(last, tail))
+  ));
+}
+
+inline char const* sse2_search (
+  char const* h,
+  ::std::size_t n,
+  char const* s,
+  ::std::size_t m
+) noexcept {
+  auto const first = _mm_set1_epi8(s[0]);
+  auto const last = _mm_set1_epi8(s[m - 1]);
+  ::std::size_t i = 0;
+  for (; i + m + 15 <= n; i += 16) {
+    auto mask = sse2_candidates(h + i, first, last, m);
+    while (mask) {
+      auto const candidate = h + i + lowest_bit(mask);
+      if (inner_match(candidate, s, m)) { return candidate; }
+      mask &= mask - 1;
+    }
+  }
+  return scalar_search(h + i, n - i, s, m);
+}
+
+inline char const* sse2_reverse_search (
+  char const* h,
+  ::std::size_t n,
+  char const* s,
+  ::std::size_t m
+) noexcept {
+  auto const first = _mm_set1_epi8(s[0]);
+  auto const last = _mm_set1_epi8(s[m - 1]);
+  auto count = n - m + 1;
+  for (; count >= 16; count -= 16) {
+    auto const i = count - 16;
+    auto mask = sse2_candidates(h + i, first, last, m);
+    while (mask) {
+      auto const bit = highest_bit(mask);
+      auto const candidate = h + i + bit;
+      if (inner_match(candidate, s, m)) { return candidate; }
+      mask &= ~(1u << bit);
+    }
+  }
+  return scalar_reverse_search(h, count + m - 1, s, m);
+}
+#endif /* defined(CORE_STRING_VIEW_SSE2) */
+
+#if defined(CORE_STRING_VIEW_AVX2)
+inline bool has_avx2 () noexcept {
+  static bool const value = (
+    __builtin_cpu_init(),
+    __builtin_cpu_supports("avx2") != 0
+  );
+  return value;
+}
+
+__attribute__((target("avx2")))
+inline unsigned avx2_candidates (
+  char const* block,
+  __m256i first,
+  __m256i last,
+  ::std::size_t m
+) noexcept {
+  auto const head = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(block));
+  auto const tail = _mm256_loadu_si256(
+    reinterpret_cast<__m256i const*>(block + m - 1)
+  );
+  return static_cast<unsigned>(_mm256_movemask_epi8(
+    _mm256_and_si256(
+      _mm256_cmpeq_epi8(first, head),
+      _mm256_cmpeq_epi8(last, tail)
+    )
+  ));
+}
+
+__attribute__((target("avx2")))
+inline char const* avx2_search (
+  char const* h,
+  ::std::size_t n,
+  char const* s,
+  ::std::size_t m
+) noexcept {
+  auto const first = _mm256_set1_epi8(s[0]);
+  auto const last = _mm256_set1_epi8(s[m - 1]);
+  ::std::size_t i = 0;
+  for (; i + m + 31 <= n; i += 32) {
+    auto mask = avx2_candidates(h + i, first, last, m);
+    while (mask) {
+      auto const candidate = h + i + lowest_bit(mask);
+      if (inner_match(candidate, s, m)) { return candidate; }
+      mask &= mask - 1;
+    }
+  }
+  return sse2_search(h + i, n - i, s, m);
+}
+
+__attribute__((target("avx2")))
+inline char const* avx2_reverse_search (
+  char const* h,
+  ::std::size_t n,
+  char const* s,
+  ::std::size_t m
+) noexcept {
+  auto const first = _mm256_set1_epi8(s[0]);
+  auto const last = _mm256_set1_epi8(s[m - 1]);
+  auto count = n - m + 1;
+  for (; count >= 32; count -= 32) {
+    auto const i = count - 32;
+    auto mask = avx2_candidates(h + i, first, last, m);
+    while (mask) {
+      auto const bit = highest_bit(mask);
+      auto const candidate = h + i + bit;
+      if (inner_match(candidate, s, m)) { return candidate; }
+      mask &= ~(1u << bit);
+    }
+  }
+  return sse2_reverse_search(h, count + m - 1, s, m);
+}
+#endif /* defined(CORE_STRING_VIEW_AVX2) */
+
+inline char const* search (
+  char const* h,
+  ::std::size_t n,
+  char const* s,
+  ::std::size_t m
+) noexcept {
+  if (m == 1) { return static_cast<char const*>(::std::memchr(h, *s, n)); }
+#if defined(CORE_STRING_VIEW_AVX2)
+  if (has_avx2()) { return avx2_search(h, n, s, m); }
+#endif /* defined(CORE_STRING_VIEW_AVX2) */
+#if defined(CORE_STRING_VIEW_SSE2)
+  return sse2_search(h, n, s, m);
+#else
+  return scalar_search(h, n, s, m);
+#endif /* defined(CORE_STRING_VIEW_SSE2) */
+}
+
+inline char const* reverse_search (
+  char const* h,
+  ::std::size_t n,
+  char const* s,
+  ::std::size_t m
+) noexcept {
+#if defined(CORE_STRING_VIEW_AVX2)
+  if (has_avx2()) { return avx2_reverse_search(h, n, s, m); }
+#endif /* defined(CORE_STRING_VIEW_AVX2) */
+#if defined(CORE_STRING_VIEW_SSE2)
+  return sse2_reverse_search(h, n, s, m);
+#else
+  return scalar_reverse_search(h, n, s, m);
+#endif /* defined(CORE_STRING_VIEW_SSE2) */
+}
+
+template <class CharT, class Predicate>
+::std::size_t find_if (
+  CharT const* h,
+  ::std::size_t n,
+  ::std::size_t pos,
+  Predicate predicate
+) noexcept {
+  for (; pos < n; ++pos) { if (predicate(h[pos])) { return pos; } }
+  return ::std::numeric_limits<::std::size_t>::max();
+}
+
+template <class CharT, class Predicate>
+::std::size_t find_last_if (
+  CharT const* h,
+  ::std::size_t n,
+  ::std::size_t pos,
+  Predicate predicate
+) noexcept {
+  if (n) {
+    for (auto p = ::std::min(pos, n - 1) + 1; p--;) {
+      if (predicate(h[p])) { return p; }
+    }
+  }
+  return ::std::numeric_limits<::std::size_t>::max();
+}
+
+/* a 256-bit membership table, built once per call so that the find_*_of
+ * family scans the string_view in O(n) rather than O(n * m)
+ */
+struct char_set final {
+  char_set (char const* s, ::std::size_t m) noexcept : bits { } {
+    while (m--) {
+      auto const c = static_cast<unsigned char>(*s++);
+      this->bits[c >> 6] |= ::std::uint64_t { 1 } << (c & 63);
+    }
+  }
+
+  bool operator () (char ch) const noexcept {
+    auto const c = static_cast<unsigned char>(ch);
+    return (this->bits[c >> 6] >> (c & 63)) & 1;
+  }
+
+private:
+  ::std::uint64_t bits[4];
+};
+
+/* this is the default case, used for any character type or traits that are
+ * not std::char_traits<char>
+ */
+template <class CharT, class Traits>
+struct search_traits {
+  static constexpr auto npos = ::std::numeric_limits<::std::size_t>::max();
+
+  static ::std::size_t find_first_of (
+    CharT const* h,
+    ::std::size_t n,
+    CharT const* s,
+    ::std::size_t m,
+    ::std::size_t pos
+  ) noexcept {
+    return find_if(h, n, pos, [s, m] (CharT c) {
+      return Traits::find(s, m, c) != nullptr;
+    });
+  }
+
+  static ::std::size_t find_first_not_of (
+    CharT const* h,
+    ::std::size_t n,
+    CharT const* s,
+    ::std::size_t m,
+    ::std::size_t pos
+  ) noexcept {
+    return find_if(h, n, pos, [s, m] (CharT c) {
+      return Traits::find(s, m, c) == nullptr;
+    });
+  }
+
+  static ::std::size_t find_last_of (
+    CharT const* h,
+    ::std::size_t n,
+    CharT const* s,
+    ::std::size_t m,
+    ::std::size_t pos
+  ) noexcept {
+    return find_last_if(h, n, pos, [s, m] (CharT c) {
+      return Traits::find(s, m, c) != nullptr;
+    });
+  }
+
+  static ::std::size_t find_last_not_of (
+    CharT const* h,
+    ::std::size_t n,
+    CharT const* s,
+    ::std::size_t m,
+    ::std::size_t pos
+  ) noexcept {
+    return find_last_if(h, n, pos, [s, m] (CharT c) {
+      return Traits::find(s, m, c) == nullptr;
+    });
+  }
+
+  static ::std::size_t find (
+    CharT const* h,
+    ::std::size_t n,
+    CharT const* s,
+    ::std::size_t m,
+    ::std::size_t pos
+  ) noexcept {
+    if (pos > n or m > n - pos) { return npos; }
+    if (not m) { return pos; }
+    auto const end = h + n;
+    auto const iter = ::std::search(h + pos, end, s, s + m, Traits::eq);
+    return iter == end ? npos : static_cast<::std::size_t>(iter - h);
+  }
+
+  static ::std::size_t rfind (
+    CharT const* h,
+    ::std::size_t n,
+    CharT const* s,
+    ::std::size_t m,
+    ::std::size_t pos
+  ) noexcept {
+    if (m > n) { return npos; }
+    for (auto p = ::std::min(pos, n - m) + 1; p--;) {
+      if (Traits::compare(h + p, s, m) == 0) { return p; }
+    }
+    return npos;
+  }
+};
+
+template <>
+struct search_traits<char, ::std::char_traits<char>> {
+  static constexpr auto npos = ::std::numeric_limits<::std::size_t>::max();
+
+  static ::std::size_t find_first_of (
+    char const* h,
+    ::std::size_t n,
+    char const* s,
+    ::std::size_t m,
+    ::std::size_t pos
+  ) noexcept {
+    if (pos >= n or not m) { return npos; }
+    if (m == 1) { return find(h, n, s, m, pos); }
+    return find_if(h, n, pos, char_set { s, m });
+  }
+
+  static ::std::size_t find_first_not_of (
+    char const* h,
+    ::std::size_t n,
+    char const* s,
+    ::std::size_t m,
+    ::std::size_t pos
+  ) noexcept {
+    auto const set = char_set { s, m };
+    return find_if(h, n, pos, [&set] (char c) { return not set(c); });
+  }
+
+  static ::std::size_t find_last_of (
+    char const* h,
+    ::std::size_t n,
+    char const* s,
+    ::std::size_t m,
+    ::std::size_t pos
+  ) noexcept {
+    if (not n or not m) { return npos; }
+    if (m == 1) { return rfind(h, n, s, m, pos); }
+    return find_last_if(h, n, pos, char_set { s, m });
+  }
+
+  static ::std::size_t find_last_not_of (
+    char const* h,
+    ::std::size_t n,
+    char const* s,
+    ::std::size_t m,
+    ::std::size_t pos
+  ) noexcept {
+    auto const set = char_set { s, m };
+    return find_last_if(h, n, pos, [&set] (char c) { return not set(c); });
+  }
+
+  static ::std::size_t find (
+    char const* h,
+    ::std::size_t n,
+    char const* s,
+    ::std::size_t m,
+    ::std::size_t pos
+  ) noexcept {
+    if (pos > n or m > n - pos) { return npos; }
+    if (not m) { return pos; }
+    auto const result = search(h + pos, n - pos, s, m);
+    return result ? static_cast<::std::size_t>(result - h) : npos;
+  }
+
+  static ::std::size_t rfind (
+    char const* h,
+    ::std::size_t n,
+    char const* s,
+    ::std::size_t m,
+    ::std::size_t pos
+  ) noexcept {
+    if (m > n) { return npos; }
+    auto const last = ::std::min(pos, n - m);
+    if (not m) { return last; }
+    auto const result = reverse_search(h, last + m, s, m);
+    return result ? static_cast<::std::size_t>(result - h) : npos;
+  }
+};
+
+/* maps each character to one past the index of its last occurrence in a
+ * needle, or zero if it does not occur. Characters are bucketed by their
+ * low byte, so wider character types share entries and the table only ever
+ * underestimates how far a searcher may skip.
+ */
+template <class CharT, class Traits>
+struct occurrence_table final {
+  occurrence_table (CharT const* s, ::std::size_t m) noexcept : last { } {
+    for (::std::size_t i = 0; i < m; ++i) { this->last[bucket(s[i])] = i + 1; }
+  }
+
+  ::std::size_t operator () (CharT c) const noexcept {
+    return this->last[bucket(c)];
+  }
+
+private:
+  static ::std::size_t bucket (CharT c) noexcept {
+    return static_cast<::std::size_t>(Traits::to_int_type(c)) & 0xFF;
+  }
+
+  ::std::size_t last[256];
+};
+
+/* Crochemore-Perrin critical factorization of a needle. Returns the length
+ * of the left half and stores the period of the right half in p.
+ */
+template <class CharT, class Traits>
+::std::size_t critical_factorization (
+  CharT const* s,
+  ::std::size_t m,
+  ::std::size_t& p,
+  bool reverse
+) noexcept {
+  ::std::size_t ms = 0;
+  ::std::size_t j = 1;
+  ::std::size_t k = 1;
+  p = 1;
+  while (j + k <= m) {
+    auto const a = s[j + k - 1];
+    auto const b = s[ms + k - 1];
+    if (Traits::eq(a, b)) {
+      if (k == p) { j += p; k = 1; }
+      else { ++k; }
+    } else if (reverse ? Traits::lt(b, a) : Traits::lt(a, b)) {
+      j += k;
+      k = 1;
+      p = j - ms;
+    } else {
+      ms = j++;
+      k = p = 1;
+    }
+  }
+  return ms;
+}
+
+
 }}} /* namespace core::v2::impl */
 
 namespace core {
@@ -346,13 +1109,10 @@ struct basic_string_view {
   size_type find_first_not_of (
     basic_string_view str,
     size_type pos = 0) const noexcept {
-    if (pos > this->size()) { return npos; }
-    auto begin = this->begin() + pos;
-    auto end = this->end();
-    auto const predicate = [str] (value_type v) { return str.find(v) == npos; };
-    auto iter = std::find_if(begin, end, predicate);
-    if (iter == end) { return npos; }
-    return static_cast<size_type>(::std::distance(this->begin(), iter));
+    return impl::search_traits<CharT, Traits>::find_first_not_of(
+      this->data(), this->size(),
+      str.data(), str.size(),
+      pos);
   }
 
   size_type find_first_not_of (
@@ -376,13 +1136,10 @@ struct basic_string_view {
   size_type find_first_of (
     basic_string_view str,
     size_type pos = 0) const noexcept {
-    if (pos > this->size()) { return npos; }
-    auto iter = ::std::find_first_of(
-      this->begin() + pos, this->end(),
-      str.begin(), str.end(),
-      traits::eq);
-    if (iter == this->end()) { return npos; }
-    return static_cast<size_type>(::std::distance(this->begin(), iter));
+    return impl::search_traits<CharT, Traits>::find_first_of(
+      this->data(), this->size(),
+      str.data(), str.size(),
+      pos);
   }
 
   size_type find_first_of (pointer s, size_type p, size_type n) const noexcept {
@@ -401,13 +1158,10 @@ struct basic_string_view {
 
   /* find */
   size_type find (basic_string_view str, size_type pos = 0) const noexcept {
-    if (pos >= this->size()) { return npos; }
-    auto iter = ::std::search(
-      this->begin() + pos, this->end(),
-      str.begin(), str.end(),
-      traits::eq);
-    if (iter == this->end()) { return npos; }
-    return static_cast<size_type>(::std::distance(this->begin(), iter));
+    return impl::search_traits<CharT, Traits>::find(
+      this->data(), this->size(),
+      str.data(), str.size(),
+      pos);
   }
 
   size_type find (pointer s, size_type p, size_type n) const noexcept {
@@ -425,15 +1179,10 @@ struct basic_string_view {
   size_type find_last_not_of (
     basic_string_view str,
     size_type pos = npos) const noexcept {
-    auto const offset = this->size() - ::std::min(this->size(), pos);
-    auto begin = this->rbegin() + static_cast<difference_type>(offset);
-    auto end = this->rend();
-    auto const predicate = [str] (value_type v) { return str.find(v) == npos; };
-    auto iter = ::std::find_if(begin, end, predicate);
-    if (iter == end) { return npos; }
-    auto const distance = static_cast<size_type>(
-      ::std::distance(this->rbegin(), iter));
-    return this->size() - distance - 1;
+    return impl::search_traits<CharT, Traits>::find_last_not_of(
+      this->data(), this->size(),
+      str.data(), str.size(),
+      pos);
   }
 
   size_type find_last_not_of (
@@ -458,18 +1207,10 @@ struct basic_string_view {
   size_type find_last_of (
     basic_string_view str,
     size_type pos = npos) const noexcept {
-    auto const offset = this->size() - ::std::min(this->size(), pos);
-    auto begin = this->rbegin() + static_cast<difference_type>(offset);
-    auto end = this->rend();
-
-    auto iter = ::std::find_first_of(
-      begin, end,
-      str.rbegin(), str.rend(),
-      traits::eq);
-    if (iter == end) { return npos; }
-    auto const distance = static_cast<size_type>(
-      ::std::distance(this->rbegin(), iter));
-    return this->size() - distance - 1;
+    return impl::search_traits<CharT, Traits>::find_last_of(
+      this->data(), this->size(),
+      str.data(), str.size(),
+      pos);
   }
 
   size_type find_last_of (pointer s, size_type p, size_type n) const noexcept {
@@ -485,17 +1226,10 @@ struct basic_string_view {
   }
 
   size_type rfind (basic_string_view str, size_type pos=npos) const noexcept {
-    auto const offset = this->size() - ::std::min(this->size(), pos);
-    auto begin = this->rbegin() + offset;
-    auto end = this->rend();
-    auto iter = ::std::search(
-      begin, end,
-      str.rbegin(), str.rend(),
-      traits::eq);
-    if (iter == end) { return npos; }
-    auto const distance = static_cast<size_type>(
-      ::std::distance(this->rbegin(), iter));
-    return this->size() - distance - 1;
+    return impl::search_traits<CharT, Traits>::rfind(
+      this->data(), this->size(),
+      str.data(), str.size(),
+      pos);
   }
 
   size_type rfind (pointer s, size_type p, size_type n) const noexcept {
@@ -521,6 +1255,10 @@ private:
   size_type len { 0 };
 };
 
+template <class CharT, class Traits>
+constexpr typename basic_string_view<CharT, Traits>::size_type
+basic_string_view<CharT, Traits>::npos;
+
 using u32string_view = basic_string_view<char32_t>;
 using u16string_view = basic_string_view<char16_t>;
 using wstring_view = basic_string_view<wchar_t>;
@@ -723,6 +1461,805 @@ void swap (
   basic_string_view<CharT, Traits>& rhs
 ) noexcept { return lhs.swap(rhs); }
 
+/* a seedable wyhash of the characters in a basic_string_view. Different
+ * seeds give unrelated hashes, which makes flooding a hash table with
+ * colliding keys much harder when the seed is not known.
+ */
+template <class CharT, class Traits=::std::char_traits<CharT>>
+struct basic_string_view_hash {
+  using argument_type = basic_string_view<CharT, Traits>;
+  using result_type = ::std::size_t;
+
+  constexpr basic_string_view_hash () noexcept = default;
+  explicit constexpr basic_string_view_hash (::std::uint64_t seed) noexcept :
+    seed { seed }
+  { }
+
+  result_type operator () (argument_type const& ref) const noexcept {
+    auto const bytes = ref.size() * sizeof(CharT);
+    return static_cast<result_type>(
+      impl::wyhash { }(ref.data(), bytes, this->seed)
+    );
+  }
+
+private:
+  ::std::uint64_t seed { 0 };
+};
+
+using u32string_view_hash = basic_string_view_hash<char32_t>;
+using u16string_view_hash = basic_string_view_hash<char16_t>;
+using wstring_view_hash = basic_string_view_hash<wchar_t>;
+using string_view_hash = basic_string_view_hash<char>;
+
+/* hashes a string_view in a constant expression. The result is equal to
+ * that of string_view_hash with the same seed wherever std::size_t is 64
+ * bits wide, so keys may be hashed at compile time and looked up at runtime.
+ */
+constexpr ::std::uint64_t string_hash (
+  string_view str,
+  ::std::uint64_t seed = 0
+) noexcept {
+  return impl::constant_wyhash(
+    str.data(),
+    str.size(),
+    seed ^ impl::constant_mix(seed ^ impl::wyhash_secret0, impl::wyhash_secret1)
+  );
+}
+
+/* string literals do not convert to string_view in a constant expression */
+template <::std::size_t N>
+constexpr ::std::uint64_t string_hash (
+  char const (&str)[N],
+  ::std::uint64_t seed = 0
+) noexcept {
+  return string_hash(string_view { str, impl::constant_length(str, N) }, seed);
+}
+
+namespace impl {
+
+template <::std::size_t N>
+struct slot_table { ::std::uint32_t slots[N]; };
+
+constexpr string_view constant_view (string_view str) noexcept { return str; }
+
+template <::std::size_t N>
+constexpr string_view constant_view (char const (&str)[N]) noexcept {
+  return string_view { str, constant_length(str, N) };
+}
+
+constexpr bool constant_equal (
+  char const* lhs,
+  char const* rhs,
+  ::std::size_t len
+) noexcept {
+  return not len or (*lhs == *rhs and constant_equal(lhs + 1, rhs + 1, len - 1));
+}
+
+template <::std::size_t N>
+constexpr ::std::size_t constant_probe (
+  slot_table<N> const& table,
+  ::std::size_t slot
+) noexcept {
+  return table.slots[slot] ? constant_probe(table, (slot + 1) % N) : slot;
+}
+
+template <::std::size_t N, ::std::size_t... Is>
+constexpr slot_table<N> constant_place (
+  slot_table<N> const& table,
+  ::std::size_t slot,
+  ::std::uint32_t value,
+  index_sequence<Is...>
+) noexcept { return slot_table<N> { { Is == slot ? value : table.slots[Is]... } }; }
+
+template <::std::size_t N>
+constexpr slot_table<N> constant_insert (
+  slot_table<N> const& table,
+  ::std::uint32_t
+) noexcept { return table; }
+
+/* linear probing, one key at a time. The slots hold 1 + the key's index so
+ * that zero marks an empty slot.
+ */
+template <::std::size_t N, class... Hashes>
+constexpr slot_table<N> constant_insert (
+  slot_table<N> const& table,
+  ::std::uint32_t index,
+  ::std::uint64_t hash,
+  Hashes... hashes
+) noexcept {
+  return constant_insert(
+    constant_place(
+      table,
+      constant_probe(table, hash % N),
+      index + 1,
+      make_index_sequence<N> { }),
+    index + 1,
+    hashes...
+  );
+}
+
+constexpr ::std::size_t slot_count (::std::size_t n, ::std::size_t count=2) {
+  return count >= 2 * n ? count : slot_count(n, count * 2);
+}
+
+} /* namespace impl */
+
+/* maps a fixed set of string keys to their indices. The open addressing
+ * table is built at compile time, with at most half of its slots used, so a
+ * lookup is one hash, usually a single probe, and one confirming compare.
+ */
+template <::std::size_t N>
+struct string_switch {
+  static_assert(N > 0, "string_switch requires at least one key");
+  static_assert(N <= 256, "string_switch supports at most 256 keys");
+
+  using size_type = ::std::size_t;
+
+  static constexpr size_type npos = ::std::numeric_limits<size_type>::max();
+
+  template <class... Keys>
+  constexpr explicit string_switch (Keys const&... values) noexcept :
+    keys { impl::constant_view(values)... },
+    hashes { string_hash(values)... },
+    table {
+      impl::constant_insert(
+        impl::slot_table<capacity> { },
+        0,
+        string_hash(values)...)
+    }
+  { static_assert(sizeof...(Keys) == N, "wrong number of keys"); }
+
+  constexpr size_type size () const noexcept { return N; }
+
+  constexpr string_view operator [] (size_type idx) const noexcept {
+    return this->keys[idx];
+  }
+
+  /* returns the index of str among the keys, or npos */
+  size_type operator () (string_view str) const noexcept {
+    auto const hash = impl::wyhash { }(str.data(), str.size(), 0);
+    for (auto slot = hash % capacity;; slot = (slot + 1) % capacity) {
+      auto const entry = this->table.slots[slot];
+      if (not entry) { return npos; }
+      auto const idx = entry - 1;
+      if (this->hashes[idx] == hash and this->keys[idx] == str) { return idx; }
+    }
+  }
+
+  /* the same lookup in a constant expression, for use in case labels */
+  template <class Key>
+  constexpr size_type index (Key const& key) const noexcept {
+    return this->find(impl::constant_view(key), string_hash(key));
+  }
+
+private:
+  static constexpr size_type capacity = impl::slot_count(N);
+
+  constexpr size_type find (
+    string_view str,
+    ::std::uint64_t hash
+  ) const noexcept { return this->probe(str, hash, hash % capacity); }
+
+  /* the recursive form of the loop in operator () */
+  constexpr size_type probe (
+    string_view str,
+    ::std::uint64_t hash,
+    size_type slot
+  ) const noexcept {
+    return not this->table.slots[slot]
+      ? npos
+      : this->matches(str, hash, this->table.slots[slot] - 1)
+        ? this->table.slots[slot] - 1
+        : this->probe(str, hash, (slot + 1) % capacity);
+  }
+
+  constexpr bool matches (
+    string_view str,
+    ::std::uint64_t hash,
+    size_type idx
+  ) const noexcept {
+    return this->hashes[idx] == hash and
+      this->keys[idx].size() == str.size() and
+      impl::constant_equal(this->keys[idx].data(), str.data(), str.size());
+  }
+
+  string_view keys[N];
+  ::std::uint64_t hashes[N];
+  impl::slot_table<capacity> table;
+};
+
+template <::std::size_t N>
+constexpr typename string_switch<N>::size_type string_switch<N>::npos;
+
+template <::std::size_t N>
+constexpr typename string_switch<N>::size_type string_switch<N>::capacity;
+
+template <class... Keys>
+constexpr string_switch<sizeof...(Keys)> make_string_switch (
+  Keys const&... keys
+) noexcept { return string_switch<sizeof...(Keys)> { keys... }; }
+
+/* searchers preprocess a needle once and may then be applied to any number
+ * of haystacks, either directly or through core::search. Like the standard
+ * searchers, they refer to the needle and do not own it.
+ */
+template <class CharT, class Traits=::std::char_traits<CharT>>
+struct boyer_moore_horspool_searcher {
+  using view_type = basic_string_view<CharT, Traits>;
+  using size_type = typename view_type::size_type;
+
+  explicit boyer_moore_horspool_searcher (view_type needle) noexcept :
+    needle { needle },
+    table { needle.data(), needle.empty() ? 0 : needle.size() - 1 }
+  { }
+
+  template <class RandomIt>
+  ::std::pair<RandomIt, RandomIt> operator () (
+    RandomIt first,
+    RandomIt last
+  ) const {
+    auto const m = this->needle.size();
+    if (not m) { return ::std::make_pair(first, first); }
+    auto const n = static_cast<size_type>(::std::distance(first, last));
+    auto const s = this->needle.data();
+    for (size_type j = 0; m <= n - j and m <= n;) {
+      auto const c = static_cast<CharT>(first[j + m - 1]);
+      if (Traits::eq(c, s[m - 1])) {
+        size_type i = 0;
+        while (i < m - 1 and Traits::eq(first[j + i], s[i])) { ++i; }
+        if (i == m - 1) { return ::std::make_pair(first + j, first + j + m); }
+      }
+      j += m - this->table(c);
+    }
+    return ::std::make_pair(last, last);
+  }
+
+private:
+  view_type needle;
+  impl::occurrence_table<CharT, Traits> table;
+};
+
+/* the Two-Way algorithm runs in linear time with constant extra space
+ * regardless of the needle, and skips ahead with the same occurrence table
+ * as boyer_moore_horspool_searcher whenever it has no prefix to remember.
+ */
+template <class CharT, class Traits=::std::char_traits<CharT>>
+struct two_way_searcher {
+  using view_type = basic_string_view<CharT, Traits>;
+  using size_type = typename view_type::size_type;
+
+  explicit two_way_searcher (view_type needle) noexcept :
+    needle { needle },
+    table { needle.data(), needle.size() },
+    suffix { 0 },
+    period { 1 },
+    memory { 0 }
+  {
+    auto const s = needle.data();
+    auto const m = needle.size();
+    size_type forward_period;
+    size_type reverse_period;
+    auto const forward = impl::critical_factorization<CharT, Traits>(
+      s,
+      m,
+      forward_period,
+      false
+    );
+    auto const reverse = impl::critical_factorization<CharT, Traits>(
+      s,
+      m,
+      reverse_period,
+      true
+    );
+    this->suffix = forward > reverse ? forward : reverse;
+    this->period = forward > reverse ? forward_period : reverse_period;
+    auto const periodic = this->suffix + this->period <= m and
+      not Traits::compare(s, s + this->period, this->suffix);
+    if (periodic) { this->memory = m - this->period; }
+    else { this->period = ::std::max(this->suffix, m - this->suffix) + 1; }
+  }
+
+  template <class RandomIt>
+  ::std::pair<RandomIt, RandomIt> operator () (
+    RandomIt first,
+    RandomIt last
+  ) const {
+    auto const m = this->needle.size();
+    if (not m) { return ::std::make_pair(first, first); }
+    auto const n = static_cast<size_type>(::std::distance(first, last));
+    auto const s = this->needle.data();
+    size_type memory = 0;
+    for (size_type j = 0; m <= n and m <= n - j;) {
+      if (not memory) {
+        auto const skip = m - this->table(first[j + m - 1]);
+        if (skip) {
+          j += skip;
+          continue;
+        }
+      }
+      auto i = ::std::max(this->suffix, memory);
+      while (i < m and Traits::eq(s[i], first[j + i])) { ++i; }
+      if (i < m) {
+        j += i - this->suffix + 1;
+        memory = 0;
+        continue;
+      }
+      auto k = this->suffix;
+      while (k > memory and Traits::eq(s[k - 1], first[j + k - 1])) { --k; }
+      if (k <= memory) { return ::std::make_pair(first + j, first + j + m); }
+      j += this->period;
+      memory = this->memory;
+    }
+    return ::std::make_pair(last, last);
+  }
+
+private:
+  view_type needle;
+  impl::occurrence_table<CharT, Traits> table;
+  size_type suffix;
+  size_type period;
+  size_type memory;
+};
+
+template <class CharT, class Traits>
+boyer_moore_horspool_searcher<CharT, Traits>
+make_boyer_moore_horspool_searcher (
+  basic_string_view<CharT, Traits> needle
+) noexcept { return boyer_moore_horspool_searcher<CharT, Traits> { needle }; }
+
+template <class CharT, class Traits>
+two_way_searcher<CharT, Traits> make_two_way_searcher (
+  basic_string_view<CharT, Traits> needle
+) noexcept { return two_way_searcher<CharT, Traits> { needle }; }
+
+/* matches any number of patterns in a single pass over the text. Patterns
+ * are compiled into an Aho-Corasick automaton over the bytes of each
+ * character. Bytes that occur in no pattern share one equivalence class.
+ * The root and every state with many edges get a dense row with one entry
+ * per class, with failure transitions already resolved. Other states keep
+ * their edges in a shared array and follow failure links until they reach
+ * an edge or a dense row.
+ */
+template <class CharT, class Traits=::std::char_traits<CharT>>
+struct aho_corasick_matcher {
+  using view_type = basic_string_view<CharT, Traits>;
+  using size_type = typename view_type::size_type;
+
+  struct match {
+    size_type pattern;
+    size_type position;
+    size_type length;
+  };
+
+  aho_corasick_matcher (::std::initializer_list<view_type> patterns) :
+    aho_corasick_matcher { patterns.begin(), patterns.end() }
+  { }
+
+  template <class InputIt>
+  aho_corasick_matcher (InputIt first, InputIt last) :
+    classes { },
+    class_count { 1 }
+  { this->compile(first, last); }
+
+  size_type size () const noexcept { return this->lengths.size(); }
+  bool empty () const noexcept { return this->lengths.empty(); }
+
+  /* calls fn with each match, including overlapping ones, ordered by where
+   * they end in text
+   */
+  template <class Function>
+  void for_each (view_type text, Function&& fn) const {
+    state_type state = 0;
+    for (size_type i = 0; i < text.size(); ++i) {
+      auto const value = static_cast<unsigned_type>(text[i]);
+      for (auto shift = width; shift--;) {
+        auto const byte = static_cast<unsigned char>(value >> (shift * 8));
+        state = this->next(state, byte);
+      }
+      auto output = this->states[state].output;
+      while (output != none) {
+        auto const& node = this->states[output];
+        for (auto pattern = node.pattern; pattern != none;) {
+          auto const length = this->lengths[pattern];
+          fn(match { pattern, i + 1 - length, length });
+          pattern = this->duplicates[pattern];
+        }
+        output = node.output_next;
+      }
+    }
+  }
+
+  ::std::vector<match> find_all (view_type text) const {
+    ::std::vector<match> matches;
+    this->for_each(text, [&matches] (match const& m) { matches.push_back(m); });
+    return matches;
+  }
+
+private:
+  using unsigned_type = typename ::std::make_unsigned<CharT>::type;
+  using state_type = ::std::uint32_t;
+
+  static constexpr state_type none = ::std::numeric_limits<state_type>::max();
+  static constexpr ::std::size_t width = sizeof(CharT);
+  static constexpr ::std::size_t dense_edges = 8;
+
+  struct state_node {
+    state_type first_edge;
+    state_type edge_count;
+    state_type fail;
+    /* offset of this state's dense row, if it has one */
+    state_type row;
+    /* the nearest state, this one included, where a pattern ends */
+    state_type output;
+    /* for states where a pattern ends, the next one on the failure chain */
+    state_type output_next;
+    /* the first pattern ending here; others are chained via duplicates */
+    state_type pattern;
+  };
+
+  state_type next (state_type state, unsigned char byte) const noexcept {
+    for (;;) {
+      auto const& node = this->states[state];
+      if (node.row != none) { return this->rows[node.row + this->classes[byte]]; }
+      auto const begin = this->labels.data() + node.first_edge;
+      auto const end = begin + node.edge_count;
+      auto const edge = ::std::find(begin, end, byte);
+      if (edge != end) { return this->targets[edge - this->labels.data()]; }
+      state = node.fail;
+    }
+  }
+
+  template <class InputIt>
+  void compile (InputIt first, InputIt last) {
+    using edge_list = ::std::vector<::std::pair<unsigned char, state_type>>;
+    ::std::vector<edge_list> trie(1);
+    ::std::vector<state_type> terminal(1, none);
+    auto const child = [&trie] (state_type s, unsigned char byte) {
+      for (auto const& edge : trie[s]) {
+        if (edge.first == byte) { return edge.second; }
+      }
+      return none;
+    };
+
+    for (; first != last; ++first) {
+      view_type const pattern { *first };
+      auto const index = static_cast<state_type>(this->lengths.size());
+      this->lengths.push_back(pattern.size());
+      this->duplicates.push_back(none);
+      if (pattern.empty()) { continue; }
+      state_type state = 0;
+      for (auto ch : pattern) {
+        auto const value = static_cast<unsigned_type>(ch);
+        for (auto shift = width; shift--;) {
+          auto const byte = static_cast<unsigned char>(value >> (shift * 8));
+          auto target = child(state, byte);
+          if (target == none) {
+            target = static_cast<state_type>(trie.size());
+            trie[state].emplace_back(byte, target);
+            trie.emplace_back();
+            terminal.push_back(none);
+          }
+          if (not this->classes[byte]) {
+            this->classes[byte] = this->class_count++;
+          }
+          state = target;
+        }
+      }
+      this->duplicates[index] = terminal[state];
+      terminal[state] = index;
+    }
+
+    this->states.resize(trie.size());
+    for (state_type s = 0; s < trie.size(); ++s) {
+      auto& edges = trie[s];
+      ::std::sort(edges.begin(), edges.end());
+      auto& node = this->states[s];
+      node.first_edge = static_cast<state_type>(this->labels.size());
+      node.edge_count = static_cast<state_type>(edges.size());
+      node.fail = 0;
+      node.row = none;
+      node.output = terminal[s] != none ? s : none;
+      node.output_next = none;
+      node.pattern = terminal[s];
+      for (auto const& edge : edges) {
+        this->labels.push_back(edge.first);
+        this->targets.push_back(edge.second);
+      }
+    }
+
+    /* breadth first, so that failure targets and their rows are finished
+     * before they are needed
+     */
+    ::std::vector<state_type> queue(1, 0);
+    queue.reserve(trie.size());
+    ::std::vector<state_type> representative(this->class_count, 0);
+    for (::std::size_t byte = 0; byte < 256; ++byte) {
+      representative[this->classes[byte]] = static_cast<state_type>(byte);
+    }
+    for (::std::size_t head = 0; head < queue.size(); ++head) {
+      auto const s = queue[head];
+      auto const fail = this->states[s].fail;
+      if (not s or trie[s].size() >= dense_edges) {
+        auto const row = static_cast<state_type>(this->rows.size());
+        this->rows.resize(this->rows.size() + this->class_count);
+        for (state_type c = 0; c < this->class_count; ++c) {
+          auto const byte = static_cast<unsigned char>(representative[c]);
+          auto const target = c ? child(s, byte) : none;
+          if (target != none) { this->rows[row + c] = target; }
+          else if (s) { this->rows[row + c] = this->next(fail, byte); }
+          else { this->rows[row + c] = 0; }
+        }
+        this->states[s].row = row;
+      }
+      for (auto const& edge : trie[s]) {
+        auto const t = edge.second;
+        auto& node = this->states[t];
+        node.fail = s ? this->next(fail, edge.first) : 0;
+        auto const output = this->states[node.fail].output;
+        node.output_next = output;
+        if (node.output == none) { node.output = output; }
+        queue.push_back(t);
+      }
+    }
+  }
+
+  ::std::uint16_t classes[256];
+  ::std::uint16_t class_count;
+  ::std::vector<state_node> states;
+  ::std::vector<state_type> rows;
+  ::std::vector<unsigned char> labels;
+  ::std::vector<state_type> targets;
+  ::std::vector<size_type> lengths;
+  ::std::vector<state_type> duplicates;
+};
+
+template <class CharT, class Traits>
+constexpr typename aho_corasick_matcher<CharT, Traits>::state_type
+aho_corasick_matcher<CharT, Traits>::none;
+
+template <class CharT, class Traits>
+constexpr ::std::size_t aho_corasick_matcher<CharT, Traits>::width;
+
+template <class CharT, class Traits>
+constexpr ::std::size_t aho_corasick_matcher<CharT, Traits>::dense_edges;
+
+namespace impl {
+
+/* delimiters for split_iterator. Each returns the position and length of
+ * the first delimiter at or after pos, or npos when there is none
+ */
+template <class CharT, class Traits>
+struct char_delimiter {
+  using view_type = basic_string_view<CharT, Traits>;
+  using result_type = ::std::pair<::std::size_t, ::std::size_t>;
+
+  result_type operator () (view_type str, ::std::size_t pos) const noexcept {
+    return result_type { str.find(this->delimiter, pos), 1 };
+  }
+
+  CharT delimiter;
+};
+
+template <class CharT, class Traits>
+struct string_delimiter {
+  using view_type = basic_string_view<CharT, Traits>;
+  using result_type = ::std::pair<::std::size_t, ::std::size_t>;
+
+  /* an empty delimiter splits between every character */
+  result_type operator () (view_type str, ::std::size_t pos) const noexcept {
+    if (this->delimiter.empty()) {
+      return result_type { pos + 1 < str.size() ? pos + 1 : view_type::npos, 0 };
+    }
+    return result_type {
+      str.find(this->delimiter, pos),
+      this->delimiter.size()
+    };
+  }
+
+  view_type delimiter;
+};
+
+template <class CharT, class Traits>
+struct any_delimiter {
+  using view_type = basic_string_view<CharT, Traits>;
+  using result_type = ::std::pair<::std::size_t, ::std::size_t>;
+
+  result_type operator () (view_type str, ::std::size_t pos) const noexcept {
+    return result_type { str.find_first_of(this->delimiters, pos), 1 };
+  }
+
+  view_type delimiters;
+};
+
+template <>
+struct any_delimiter<char, ::std::char_traits<char>> {
+  using view_type = basic_string_view<char>;
+  using result_type = ::std::pair<::std::size_t, ::std::size_t>;
+
+  explicit any_delimiter (view_type delimiters) noexcept :
+    set { delimiters.data(), delimiters.size() }
+  { }
+
+  result_type operator () (view_type str, ::std::size_t pos) const noexcept {
+    return result_type { find_if(str.data(), str.size(), pos, this->set), 1 };
+  }
+
+  char_set set;
+};
+
+/* lambdas are copy constructible but not assignable, while iterators must
+ * be both. The predicate is held in a union so that assignment can destroy
+ * the old one and copy construct the new one in its place.
+ */
+template <class CharT, class Traits, class Predicate>
+struct predicate_delimiter {
+  using view_type = basic_string_view<CharT, Traits>;
+  using result_type = ::std::pair<::std::size_t, ::std::size_t>;
+
+  explicit predicate_delimiter (Predicate predicate) :
+    predicate { ::core::move(predicate) },
+    engaged { true }
+  { }
+
+  predicate_delimiter (predicate_delimiter const& that) :
+    engaged { false }
+  { this->assign(that); }
+
+  ~predicate_delimiter () noexcept { this->reset(); }
+
+  predicate_delimiter& operator = (predicate_delimiter const& that) {
+    if (this != &that) {
+      this->reset();
+      this->assign(that);
+    }
+    return *this;
+  }
+
+  result_type operator () (view_type str, ::std::size_t pos) const {
+    for (; pos < str.size(); ++pos) {
+      if (this->predicate(str[pos])) { return result_type { pos, 1 }; }
+    }
+    return result_type { view_type::npos, 1 };
+  }
+
+private:
+  /* engaged is only set once the copy has succeeded */
+  void assign (predicate_delimiter const& that) {
+    if (not that.engaged) { return; }
+    ::new (::core::as_void(this->predicate)) Predicate(that.predicate);
+    this->engaged = true;
+  }
+
+  void reset () noexcept {
+    if (not this->engaged) { return; }
+    this->predicate.~Predicate();
+    this->engaged = false;
+  }
+
+  union { Predicate predicate; };
+  bool engaged;
+};
+
+} /* namespace impl */
+
+/* a forward iterator over the pieces of a basic_string_view between
+ * delimiters. Each piece is a view into the original string, so nothing is
+ * copied or allocated.
+ */
+template <class CharT, class Traits, class Delimiter>
+struct split_iterator {
+  using iterator_category = ::std::forward_iterator_tag;
+  using value_type = basic_string_view<CharT, Traits>;
+  using difference_type = ::std::ptrdiff_t;
+  using reference = value_type const&;
+  using pointer = value_type const*;
+
+  split_iterator (value_type str, Delimiter delimiter) :
+    str { str },
+    delimiter(::core::move(delimiter)),
+    start { str.empty() ? value_type::npos : 0 }
+  { if (not str.empty()) { this->locate(); } }
+
+  /* the end iterator. It only needs a delimiter because predicates such as
+   * lambdas cannot be default constructed
+   */
+  explicit split_iterator (Delimiter delimiter) :
+    delimiter(::core::move(delimiter))
+  { }
+
+  split_iterator () = default;
+
+  reference operator * () const noexcept { return this->current; }
+  pointer operator -> () const noexcept { return &this->current; }
+
+  split_iterator& operator ++ () {
+    this->start = this->next;
+    if (this->start != value_type::npos) { this->locate(); }
+    return *this;
+  }
+
+  split_iterator operator ++ (int) {
+    auto copy = *this;
+    ++*this;
+    return copy;
+  }
+
+  bool operator == (split_iterator const& that) const noexcept {
+    return this->start == that.start;
+  }
+
+  bool operator != (split_iterator const& that) const noexcept {
+    return this->start != that.start;
+  }
+
+private:
+  void locate () {
+    auto const found = this->delimiter(this->str, this->start);
+    auto const stop = ::std::min(found.first, this->str.size());
+    this->current = this->str.substr(this->start, stop - this->start);
+    this->next = found.first == value_type::npos
+      ? value_type::npos
+      : found.first + found.second;
+  }
+
+  value_type str { };
+  value_type current { };
+  Delimiter delimiter;
+  ::std::size_t start { value_type::npos };
+  ::std::size_t next { value_type::npos };
+};
+
+template <class CharT, class Traits>
+range<split_iterator<CharT, Traits, impl::char_delimiter<CharT, Traits>>>
+split (basic_string_view<CharT, Traits> str, CharT delimiter) {
+  using delimiter_type = impl::char_delimiter<CharT, Traits>;
+  using iterator = split_iterator<CharT, Traits, delimiter_type>;
+  auto const finder = delimiter_type { delimiter };
+  return make_range(iterator { str, finder }, iterator { finder });
+}
+
+template <class CharT, class Traits>
+range<split_iterator<CharT, Traits, impl::string_delimiter<CharT, Traits>>>
+split (
+  basic_string_view<CharT, Traits> str,
+  identity_t<basic_string_view<CharT, Traits>> delimiter
+) {
+  using delimiter_type = impl::string_delimiter<CharT, Traits>;
+  using iterator = split_iterator<CharT, Traits, delimiter_type>;
+  auto const finder = delimiter_type { delimiter };
+  return make_range(iterator { str, finder }, iterator { finder });
+}
+
+template <class CharT, class Traits>
+range<split_iterator<CharT, Traits, impl::any_delimiter<CharT, Traits>>>
+split_any (
+  basic_string_view<CharT, Traits> str,
+  identity_t<basic_string_view<CharT, Traits>> delimiters
+) {
+  using delimiter_type = impl::any_delimiter<CharT, Traits>;
+  using iterator = split_iterator<CharT, Traits, delimiter_type>;
+  auto const finder = delimiter_type { delimiters };
+  return make_range(iterator { str, finder }, iterator { finder });
+}
+
+template <class CharT, class Traits, class Predicate>
+range<
+  split_iterator<
+    CharT,
+    Traits,
+    impl::predicate_delimiter<CharT, Traits, decay_t<Predicate>>
+  >
+> split_if (basic_string_view<CharT, Traits> str, Predicate&& predicate) {
+  using delimiter_type = impl::predicate_delimiter<
+    CharT,
+    Traits,
+    decay_t<Predicate>
+  >;
+  using iterator = split_iterator<CharT, Traits, delimiter_type>;
+  auto const finder = delimiter_type { ::core::forward<Predicate>(predicate) };
+  return make_range(iterator { str, finder }, iterator { finder });
+}
+
 }} /* namespace core::v2 */
 
 namespace std {
@@ -733,8 +2270,12 @@ struct hash<core::v2::basic_string_view<CharT, Traits>> {
   using result_type = size_t;
 
   result_type operator ()(argument_type const& ref) const noexcept {
+#if defined(CORE_MURMUR_HASH)
     static constexpr core::impl::murmur<sizeof(size_t)> hasher { };
-    return hasher(ref.data(), ref.size());
+    return hasher(ref.data(), ref.size() * sizeof(CharT));
+#else
+    return core::basic_string_view_hash<CharT, Traits> { }(ref);
+#endif /* defined(CORE_MURMUR_HASH) */
   }
 };
 
@@ -0,0 +1,471 @@
+#ifndef CORE_UTF8_HPP
+#define CORE_UTF8_HPP
+
+#include <iterator>
+
+#include <cstdint>
+#include <cstring>
+
+#include <core/string_view.hpp>
+#include <core/range.hpp>
+
+namespace core {
+inline namespace v2 {
+namespace impl {
+
+struct utf8_decoded final {
+  char32_t value;
+  unsigned length;
+  bool valid;
+};
+
+/* decodes the sequence starting at p, which must be before end. An invalid
+ * sequence decodes to U+FFFD, and its length is that of its longest valid
+ * prefix (at least 1), as recommended by the Unicode standard.
+ */
+inline utf8_decoded decode_utf8 (
+  ::std::uint8_t const* p,
+  ::std::uint8_t const* end
+) noexcept {
+  auto const lead = p[0];
+  if (lead < 0x80) { return utf8_decoded { lead, 1, true }; }
+  unsigned length;
+  char32_t value;
+  ::std::uint8_t lower = 0x80;
+  ::std::uint8_t upper = 0xBF;
+  if (lead < 0xC2) { return utf8_decoded { 0xFFFD, 1, false }; }
+  else if (lead < 0xE0) {
+    length = 2;
+    value = lead & 0x1Fu;
+  } else if (lead < 0xF0) {
+    length = 3;
+    value = lead & 0x0Fu;
+    if (lead == 0xE0) { lower = 0xA0; }
+    if (lead == 0xED) { upper = 0x9F; }
+  } else if (lead < 0xF5) {
+    length = 4;
+    value = lead & 0x07u;
+    if (lead == 0xF0) { lower = 0x90; }
+    if (lead == 0xF4) { upper = 0x8F; }
+  } else { return utf8_decoded { 0xFFFD, 1, false }; }
+  for (unsigned i = 1; i < length; ++i) {
+    if (p + i == end or p[i] < lower or p[i] > upper) {
+      return utf8_decoded { 0xFFFD, i, false };
+    }
+    value = (value << 6) | (p[i] & 0x3Fu);
+    lower = 0x80;
+    upper = 0xBF;
+  }
+  return utf8_decoded { value, length, true };
+}
+
+inline char const* scalar_find_invalid_utf8 (
+  char const* first,
+  char const* last
+) noexcept {
+  auto p = reinterpret_cast<::std::uint8_t const*>(first);
+  auto const end = reinterpret_cast<::std::uint8_t const*>(last);
+  while (p != end) {
+    if (end - p >= 8 and not (load64(p) & UINT64_C(0x8080808080808080))) {
+      p += 8;
+      continue;
+    }
+    if (*p < 0x80) {
+      ++p;
+      continue;
+    }
+    auto const decoded = decode_utf8(p, end);
+    if (not decoded.valid) { return reinterpret_cast<char const*>(p); }
+    p += decoded.length;
+  }
+  return last;
+}
+
+inline ::std::size_t scalar_count_code_points (
+  char const* first,
+  char const* last
+) noexcept {
+  ::std::size_t count = 0;
+  for (; first != last; ++first) {
+    count += (static_cast<unsigned char>(*first) & 0xC0u) != 0x80u;
+  }
+  return count;
+}
+
+#if defined(CORE_STRING_VIEW_SSE2)
+/* skips ASCII 16 bytes at a time, and decodes everything else one sequence
+ * at a time
+ */
+inline char const* sse2_find_invalid_utf8 (
+  char const* first,
+  char const* last
+) noexcept {
+  auto const end = reinterpret_cast<::std::uint8_t const*>(last);
+  while (last - first >= 16) {
+    auto const block = _mm_loadu_si128(reinterpret_cast<__m128i const*>(first));
+    auto const mask = static_cast<unsigned>(_mm_movemask_epi8(block));
+    if (not mask) {
+      first += 16;
+      continue;
+    }
+    auto p = reinterpret_cast<::std::uint8_t const*>(first + lowest_bit(mask));
+    do {
+      auto const decoded = decode_utf8(p, end);
+      if (not decoded.valid) { return reinterpret_cast<char const*>(p); }
+      p += decoded.length;
+    } while (p != end and *p >= 0x80);
+    first = reinterpret_cast<char const*>(p);
+  }
+  return scalar_find_invalid_utf8(first, last);
+}
+
+/* counts bytes that are not continuation bytes. Per-byte counters are
+ * widened with _mm_sad_epu8 before they can overflow.
+ */
+inline ::std::size_t sse2_count_code_points (
+  char const* first,
+  char const* last
+) noexcept {
+  auto const threshold = _mm_set1_epi8(-65);
+  auto const zero = _mm_setzero_si128();
+  ::std::size_t count = 0;
+  while (last - first >= 16) {
+    auto counters = zero;
+    for (auto rounds = 0; rounds < 255 and last - first >= 16; ++rounds) {
+      auto const block = _mm_loadu_si128(
+        reinterpret_cast<__m128i const*>(first)
+      );
+      counters = _mm_sub_epi8(counters, _mm_cmpgt_epi8(block, threshold));
+      first += 16;
+    }
+    auto const sums = _mm_sad_epu8(counters, zero);
+    count += static_cast<::std::size_t>(_mm_cvtsi128_si32(sums));
+    count += static_cast<::std::size_t>(
+      _mm_cvtsi128_si32(_mm_srli_si128(sums, 8))
+    );
+  }
+  return count + scalar_count_code_points(first, last);
+}
+#endif /* defined(CORE_STRING_VIEW_SSE2) */
+
+#if defined(CORE_STRING_VIEW_AVX2)
+/* the lookup algorithm of Keiser and Lemire, "Validating UTF-8 In Less Than
+ * One Instruction Per Byte". Every byte is classified by three 16 entry
+ * table lookups, on the high and low nibble of the previous byte and the
+ * high nibble of the current byte. Each bit of the result marks one kind of
+ * error within a two byte window. The only errors that need more context
+ * (missing or extra continuations after a 3 or 4 byte lead) are found by
+ * comparing against the bytes two and three positions back.
+ */
+struct avx2_utf8_validator final {
+  __attribute__((target("avx2")))
+  avx2_utf8_validator () noexcept {
+    constexpr char too_short = 1 << 0;
+    constexpr char too_long = 1 << 1;
+    constexpr char overlong_3 = 1 << 2;
+    constexpr char too_large = 1 << 3;
+    constexpr char surrogate = 1 << 4;
+    constexpr char overlong_2 = 1 << 5;
+    constexpr char too_large_1000 = 1 << 6;
+    constexpr char overlong_4 = 1 << 6;
+    constexpr char two_conts = static_cast<char>(1 << 7);
+    constexpr char carry = too_short | too_long | two_conts;
+
+    this->byte_1_high = _mm256_broadcastsi128_si256(_mm_setr_epi8(
+      too_long, too_long, too_long, too_long,
+      too_long, too_long, too_long, too_long,
+      two_conts, two_conts, two_conts, two_conts,
+      too_short | overlong_2,
+      too_short,
+      too_short | overlong_3 | surrogate,
+      too_short | too_large | too_large_1000 | overlong_4
+    ));
+    this->byte_1_low = _mm256_broadcastsi128_si256(_mm_setr_epi8(
+      carry | overlong_3 | overlong_2 | overlong_4,
+      carry | overlong_2,
+      carry,
+      carry,
+      carry | too_large,
+      carry | too_large | too_large_1000,
+      carry | too_large | too_large_1000,
+      carry | too_large | too_large_1000,
+      carry | too_large | too_large_1000,
+      carry | too_large | too_large_1000,
+      carry | too_large | too_large_1000,
+      carry | too_large | too_large_1000,
+      carry | too_large | too_large_1000,
+      carry | too_large | too_large_1000 | surrogate,
+      carry | too_large | too_large_1000,
+      carry | too_large | too_large_1000
+    ));
+    this->byte_2_high = _mm256_broadcastsi128_si256(_mm_setr_epi8(
+      too_short, too_short, too_short, too_short,
+      too_short, too_short, too_short, too_short,
+      too_long | overlong_2 | two_conts | overlong_3 | too_large_1000
+        | overlong_4,
+      too_long | overlong_2 | two_conts | overlong_3 | too_large,
+      too_long | overlong_2 | two_conts | surrogate | too_large,
+      too_long | overlong_2 | two_conts | surrogate | too_large,
+      too_short, too_short, too_short, too_short
+    ));
+    /* bytes in the last three positions that start a longer sequence */
+    this->incomplete = _mm256_setr_epi8(
+      -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+      -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+      static_cast<char>(0xF0 - 1),
+      static_cast<char>(0xE0 - 1),
+      static_cast<char>(0xC0 - 1)
+    );
+  }
+
+  __attribute__((target("avx2")))
+  void check (__m256i input) noexcept {
+    if (not _mm256_movemask_epi8(input)) {
+      this->error = _mm256_or_si256(this->error, this->previous_incomplete);
+      return;
+    }
+    auto const nibble = _mm256_set1_epi8(0x0F);
+    auto const shifted = _mm256_permute2x128_si256(
+      this->previous,
+      input,
+      0x21
+    );
+    auto const prev1 = _mm256_alignr_epi8(input, shifted, 15);
+    auto const prev2 = _mm256_alignr_epi8(input, shifted, 14);
+    auto const prev3 = _mm256_alignr_epi8(input, shifted, 13);
+
+    auto const special = _mm256_and_si256(
+      _mm256_and_si256(
+        _mm256_shuffle_epi8(
+          this->byte_1_high,
+          _mm256_and_si256(_mm256_srli_epi16(prev1, 4), nibble)
+        ),
+        _mm256_shuffle_epi8(this->byte_1_low, _mm256_and_si256(prev1, nibble))
+      ),
+      _mm256_shuffle_epi8(
+        this->byte_2_high,
+        _mm256_and_si256(_mm256_srli_epi16(input, 4), nibble)
+      )
+    );
+    auto const third = _mm256_subs_epu8(prev2, _mm256_set1_epi8(0xE0 - 0x80));
+    auto const fourth = _mm256_subs_epu8(
+      prev3,
+      _mm256_set1_epi8(0xF0 - 0x80)
+    );
+    auto const continuations = _mm256_and_si256(
+      _mm256_or_si256(third, fourth),
+      _mm256_set1_epi8(static_cast<char>(0x80))
+    );
+    this->error = _mm256_or_si256(
+      this->error,
+      _mm256_xor_si256(continuations, special)
+    );
+    this->previous_incomplete = _mm256_subs_epu8(input, this->incomplete);
+    this->previous = input;
+  }
+
+  __attribute__((target("avx2")))
+  bool failed () const noexcept {
+    return not _mm256_testz_si256(this->error, this->error);
+  }
+
+  __attribute__((target("avx2")))
+  void finish () noexcept {
+    this->error = _mm256_or_si256(this->error, this->previous_incomplete);
+  }
+
+private:
+  __m256i byte_1_high;
+  __m256i byte_1_low;
+  __m256i byte_2_high;
+  __m256i incomplete;
+  __m256i error { };
+  __m256i previous { };
+  __m256i previous_incomplete { };
+};
+
+/* validates 64 bytes between checks for an error. Once one is found, every
+ * byte before the current 64 is known to be valid, apart from an unfinished
+ * sequence at the very end. The scalar validator restarts from the nearest
+ * sequence boundary to report the exact position.
+ */
+__attribute__((target("avx2")))
+inline char const* avx2_find_invalid_utf8 (
+  char const* first,
+  char const* last
+) noexcept {
+  if (first == last) { return last; }
+  avx2_utf8_validator validator { };
+  auto block = first;
+  for (; last - block >= 64; block += 64) {
+    validator.check(
+      _mm256_loadu_si256(reinterpret_cast<__m256i const*>(block))
+    );
+    validator.check(
+      _mm256_loadu_si256(reinterpret_cast<__m256i const*>(block + 32))
+    );
+    if (validator.failed()) { break; }
+  }
+  if (last - block < 64) {
+    char buffer[64] { };
+    ::std::memcpy(buffer, block, static_cast<::std::size_t>(last - block));
+    validator.check(
+      _mm256_loadu_si256(reinterpret_cast<__m256i const*>(buffer))
+    );
+    validator.check(
+      _mm256_loadu_si256(reinterpret_cast<__m256i const*>(buffer + 32))
+    );
+    validator.finish();
+    if (not validator.failed()) { return last; }
+  }
+  auto resume = block - ::std::min<::std::ptrdiff_t>(block - first, 3);
+  while (
+    resume != block and
+    (static_cast<unsigned char>(*resume) & 0xC0u) == 0x80u
+  ) { ++resume; }
+  return scalar_find_invalid_utf8(resume, last);
+}
+
+__attribute__((target("avx2")))
+inline ::std::size_t avx2_count_code_points (
+  char const* first,
+  char const* last
+) noexcept {
+  auto const threshold = _mm256_set1_epi8(-65);
+  auto const zero = _mm256_setzero_si256();
+  auto totals = zero;
+  while (last - first >= 32) {
+    auto counters = zero;
+    for (auto rounds = 0; rounds < 255 and last - first >= 32; ++rounds) {
+      auto const block = _mm256_loadu_si256(
+        reinterpret_cast<__m256i const*>(first)
+      );
+      counters = _mm256_sub_epi8(
+        counters,
+        _mm256_cmpgt_epi8(block, threshold)
+      );
+      first += 32;
+    }
+    totals = _mm256_add_epi64(totals, _mm256_sad_epu8(counters, zero));
+  }
+  alignas(32) ::std::uint64_t lanes[4];
+  _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), totals);
+  auto const count = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+  return static_cast<::std::size_t>(count)
+    + scalar_count_code_points(first, last);
+}
+#endif /* defined(CORE_STRING_VIEW_AVX2) */
+
+inline char const* find_invalid_utf8 (
+  char const* first,
+  char const* last
+) noexcept {
+#if defined(CORE_STRING_VIEW_AVX2)
+  if (has_avx2()) { return avx2_find_invalid_utf8(first, last); }
+#endif /* defined(CORE_STRING_VIEW_AVX2) */
+#if defined(CORE_STRING_VIEW_SSE2)
+  return sse2_find_invalid_utf8(first, last);
+#else
+  return scalar_find_invalid_utf8(first, last);
+#endif /* defined(CORE_STRING_VIEW_SSE2) */
+}
+
+} /* namespace impl */
+
+/* iterates over the code points of a UTF-8 string. Invalid sequences are
+ * read as U+FFFD, so iteration always terminates, and a valid string is
+ * never misread.
+ */
+struct utf8_iterator final {
+  using iterator_category = ::std::forward_iterator_tag;
+  using value_type = char32_t;
+  using difference_type = ::std::ptrdiff_t;
+  using reference = char32_t;
+  using pointer = void;
+
+  utf8_iterator (char const* position, char const* end) noexcept :
+    position { reinterpret_cast<::std::uint8_t const*>(position) },
+    end { reinterpret_cast<::std::uint8_t const*>(end) }
+  { }
+
+  utf8_iterator () noexcept = default;
+
+  reference operator * () const noexcept {
+    if (*this->position < 0x80) { return *this->position; }
+    return impl::decode_utf8(this->position, this->end).value;
+  }
+
+  utf8_iterator& operator ++ () noexcept {
+    if (*this->position < 0x80) { ++this->position; }
+    else {
+      this->position += impl::decode_utf8(this->position, this->end).length;
+    }
+    return *this;
+  }
+
+  utf8_iterator operator ++ (int) noexcept {
+    auto copy = *this;
+    ++*this;
+    return copy;
+  }
+
+  /* the position in the string of the current code point */
+  char const* base () const noexcept {
+    return reinterpret_cast<char const*>(this->position);
+  }
+
+  bool operator == (utf8_iterator const& that) const noexcept {
+    return this->position == that.position;
+  }
+
+  bool operator != (utf8_iterator const& that) const noexcept {
+    return this->position != that.position;
+  }
+
+private:
+  ::std::uint8_t const* position { nullptr };
+  ::std::uint8_t const* end { nullptr };
+};
+
+/* returns the offset of the first byte that is not part of a valid UTF-8
+ * sequence, or npos. Overlong encodings, surrogates, values above U+10FFFF and
+ * truncated sequences are all invalid.
+ */
+inline string_view::size_type find_invalid_utf8 (string_view str) noexcept {
+  auto const last = str.data() + str.size();
+  auto const found = impl::find_invalid_utf8(str.data(), last);
+  if (found == last) { return string_view::npos; }
+  return static_cast<string_view::size_type>(found - str.data());
+}
+
+inline bool is_valid_utf8 (string_view str) noexcept {
+  return find_invalid_utf8(str) == string_view::npos;
+}
+
+/* counts the bytes that are not continuation bytes, which is the number of
+ * code points in valid UTF-8
+ */
+inline ::std::size_t count_code_points (string_view str) noexcept {
+  auto const first = str.data();
+  auto const last = first + str.size();
+#if defined(CORE_STRING_VIEW_AVX2)
+  if (impl::has_avx2()) { return impl::avx2_count_code_points(first, last); }
+#endif /* defined(CORE_STRING_VIEW_AVX2) */
+#if defined(CORE_STRING_VIEW_SSE2)
+  return impl::sse2_count_code_points(first, last);
+#else
+  return impl::scalar_count_code_points(first, last);
+#endif /* defined(CORE_STRING_VIEW_SSE2) */
+}
+
+inline range<utf8_iterator> code_points (string_view str) noexcept {
+  auto const last = str.data() + str.size();
+  return make_range(
+    utf8_iterator { str.data(), last },
+    utf8_iterator { last, last }
+  );
+}
+
+}} /* namespace core::v2 */
+
+#endif /* CORE_UTF8_HPP */
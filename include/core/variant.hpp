@@ -10,6 +10,8 @@
 #include <stdexcept>
 #include <typeinfo>
 #include <limits>
+#include <vector>
+#include <tuple>
 
 #include <cstdlib>
 #include <cstdint>
@@ -32,6 +34,117 @@ auto gen () -> Result {
   };
 }
 
+/* Visitation strategies. Small variants dispatch through an if-chain, which
+ * compilers lower to compares or a jump table and, unlike an indirect call
+ * through a table of function pointers, can inline each branch. Larger
+ * variants keep the table so that dispatch remains a single lookup.
+ */
+constexpr ::std::size_t visit_chain_limit () noexcept { return 8; }
+
+template <class Result, class... Ts> struct visit_chain;
+template <class Result, class T>
+struct visit_chain<Result, T> {
+  template <class Visitor, class Data, class... Args>
+  static Result call (
+    ::std::size_t,
+    Visitor&& visitor,
+    Data* data,
+    Args&&... args
+  ) {
+    return ::core::v2::invoke(
+      ::core::forward<Visitor>(visitor),
+      *static_cast<T*>(data),
+      ::core::forward<Args>(args)...
+    );
+  }
+};
+
+template <class Result, class T, class... Ts>
+struct visit_chain<Result, T, Ts...> {
+  template <class Visitor, class Data, class... Args>
+  static Result call (
+    ::std::size_t tag,
+    Visitor&& visitor,
+    Data* data,
+    Args&&... args
+  ) {
+    if (tag == 0) {
+      return visit_chain<Result, T>::call(
+        tag,
+        ::core::forward<Visitor>(visitor),
+        data,
+        ::core::forward<Args>(args)...
+      );
+    }
+    return visit_chain<Result, Ts...>::call(
+      tag - 1,
+      ::core::forward<Visitor>(visitor),
+      data,
+      ::core::forward<Args>(args)...
+    );
+  }
+};
+
+template <class Result, class... Ts>
+struct visit_table {
+  template <class Visitor, class Data, class... Args>
+  static Result call (
+    ::std::size_t tag,
+    Visitor&& visitor,
+    Data* data,
+    Args&&... args
+  ) {
+    using function = add_pointer_t<Result(Visitor&&, Data*, Args&&...)>;
+    static auto const callers = make_array(
+      gen<Visitor, Ts, Data, function, Args...>()...
+    );
+    return callers[tag](
+      ::core::forward<Visitor>(visitor),
+      data,
+      ::core::forward<Args>(args)...
+    );
+  }
+};
+
+template <class Result, class... Ts>
+using visit_strategy = meta::either<
+  sizeof...(Ts) <= visit_chain_limit(),
+  visit_chain<Result, Ts...>,
+  visit_table<Result, Ts...>
+>;
+
+/* vector<bool> packs its values and cannot hand out a bool&, so variant_vector
+ * stores bool alternatives in a wrapper of the same size instead.
+ */
+struct variant_vector_bool final {
+  constexpr variant_vector_bool (bool state=false) noexcept :
+    value { state }
+  { }
+  bool value;
+};
+
+template <class T> struct variant_vector_slot { using type = T; };
+template <> struct variant_vector_slot<bool> {
+  using type = variant_vector_bool;
+};
+
+template <class T>
+using variant_vector_slot_t = typename variant_vector_slot<T>::type;
+
+template <class T> T& variant_vector_value (T& slot) noexcept { return slot; }
+inline bool& variant_vector_value (variant_vector_bool& slot) noexcept {
+  return slot.value;
+}
+inline bool const& variant_vector_value (
+  variant_vector_bool const& slot
+) noexcept { return slot.value; }
+
+template <class Variant>
+struct variant_vector_loader final {
+  template <class T>
+  Variant operator () (T const& value) const { return Variant { value }; }
+};
+
 template <class, class, class...> struct result;
 template <class V, class... Ts, class... Args>
 struct result<V, meta::list<Ts...>, Args...> final : ::std::conditional<
@@ -86,6 +199,238 @@ auto make_overload(Lambdas&&... lambdas) -> overload<Lambdas...> {
   return overload<Lambdas...> { pass<Lambdas>(lambdas)... };
 }
 
+/* Type-erased lifetime operations used by variant_storage when at least one
+ * alternative is not trivial. Each is instantiated once per alternative and
+ * indexed by the variant's tag.
+ */
+template <class T>
+void variant_destroy (void* ptr) noexcept { static_cast<T*>(ptr)->~T(); }
+
+template <class T>
+void variant_copy (void* ptr, void const* that) {
+  ::new (ptr) T(*static_cast<T const*>(that));
+}
+
+template <class T>
+void variant_move (void* ptr, void* that) {
+  ::new (ptr) T(::core::move(*static_cast<T*>(that)));
+}
+
+using variant_move_function = add_pointer_t<void(void*, void*)>;
+
+/* moving an alternative back into place after a failed replacement. If
+ * that throws as well there is no value left to hold, so it terminates.
+ */
+template <class T>
+void variant_restore (void* ptr, void* backup) noexcept {
+  variant_move<T>(ptr, backup);
+}
+
+/* replaces the T at ptr with whatever construct builds from that, when
+ * construct might throw. The T is moved aside first, and moved back if
+ * construct throws, so the storage always holds the alternative its tag
+ * names.
+ */
+template <class T>
+void variant_replace (
+  void* ptr,
+  variant_move_function construct,
+  void* that
+) {
+#ifndef CORE_NO_EXCEPTIONS
+  aligned_storage_t<sizeof(T), alignof(T)> backup;
+  variant_move<T>(::std::addressof(backup), ptr);
+  variant_destroy<T>(ptr);
+  try { construct(ptr, that); }
+  catch (...) {
+    variant_restore<T>(ptr, ::std::addressof(backup));
+    variant_destroy<T>(::std::addressof(backup));
+    throw;
+  }
+  variant_destroy<T>(::std::addressof(backup));
+#else /* CORE_NO_EXCEPTIONS */
+  variant_destroy<T>(ptr);
+  construct(ptr, that);
+#endif /* CORE_NO_EXCEPTIONS */
+}
+
+/* stores the T at that in place of the T at ptr, for alternatives that
+ * cannot be assigned. A move that might throw goes through variant_replace.
+ */
+template <class T>
+auto variant_rebuild (void* ptr, void* that) -> meta::when<
+  ::std::is_nothrow_move_constructible<T>::value
+> {
+  variant_destroy<T>(ptr);
+  variant_move<T>(ptr, that);
+}
+
+template <class T>
+auto variant_rebuild (void* ptr, void* that) -> meta::unless<
+  ::std::is_nothrow_move_constructible<T>::value
+> { variant_replace<T>(ptr, variant_move<T>, that); }
+
+/* When both sides hold the same alternative, assignment is forwarded to the
+ * alternative itself so that it may reuse any resources it already owns.
+ * Alternatives that are not assignable fall back to destroy and construct.
+ */
+template <class T>
+auto variant_copy_assign (void* ptr, void const* that) -> meta::when<
+  ::std::is_copy_assignable<T>::value
+> { *static_cast<T*>(ptr) = *static_cast<T const*>(that); }
+
+template <class T>
+auto variant_copy_assign (void* ptr, void const* that) -> meta::unless<
+  ::std::is_copy_assignable<T>::value
+> {
+  T temp(*static_cast<T const*>(that));
+  variant_rebuild<T>(ptr, ::std::addressof(temp));
+}
+
+template <class T>
+auto variant_move_assign (void* ptr, void* that) -> meta::when<
+  ::std::is_move_assignable<T>::value
+> { *static_cast<T*>(ptr) = ::core::move(*static_cast<T*>(that)); }
+
+template <class T>
+auto variant_move_assign (void* ptr, void* that) -> meta::unless<
+  ::std::is_move_assignable<T>::value
+> { variant_rebuild<T>(ptr, that); }
+
+template <class T>
+using is_trivial_alternative = meta::all_t<
+  ::std::is_trivially_copyable<T>::value,
+  ::std::is_trivially_destructible<T>::value
+>;
+
+/* this is the default 'false' case */
+template <class T, bool = meta::all_of<T, is_trivial_alternative>()>
+struct variant_storage;
+
+template <class... Ts>
+struct variant_storage<meta::list<Ts...>, false> {
+  using storage_type = aligned_union_t<0, Ts...>;
+
+  static constexpr bool nothrow_move () noexcept {
+    return meta::all_of<
+      meta::list<Ts...>,
+      ::std::is_nothrow_move_constructible
+    >();
+  }
+
+  static constexpr bool nothrow_move_assign () noexcept {
+    return meta::all_of<meta::list<Ts...>, ::std::is_nothrow_move_assignable>();
+  }
+
+  explicit variant_storage (::std::size_t tag) noexcept :
+    data { },
+    tag { tag }
+  { }
+
+  variant_storage (variant_storage const& that) :
+    data { },
+    tag { that.tag }
+  { this->copy(that); }
+
+  variant_storage (variant_storage&& that) noexcept(nothrow_move()) :
+    data { },
+    tag { that.tag }
+  { this->move(that); }
+
+  ~variant_storage () noexcept { this->destroy(); }
+
+  variant_storage& operator = (variant_storage const& that) {
+    if (this == ::std::addressof(that)) { return *this; }
+    if (this->tag == that.tag) {
+      using function = add_pointer_t<void(void*, void const*)>;
+      static function const callers[] = { variant_copy_assign<Ts>... };
+      callers[this->tag](this->target(), that.target());
+      return *this;
+    }
+    variant_storage temp { that };
+    return *this = ::core::move(temp);
+  }
+
+  /* when the incoming alternative might throw while being moved, the held
+   * one is kept aside until the move succeeds, so that the tag never names
+   * a destroyed object
+   */
+  variant_storage& operator = (variant_storage&& that) noexcept(
+    nothrow_move() and nothrow_move_assign()
+  ) {
+    if (this == ::std::addressof(that)) { return *this; }
+    if (this->tag == that.tag) {
+      using function = add_pointer_t<void(void*, void*)>;
+      static function const callers[] = { variant_move_assign<Ts>... };
+      callers[this->tag](this->target(), that.target());
+      return *this;
+    }
+    static bool const nothrow[] = {
+      ::std::is_nothrow_move_constructible<Ts>::value...
+    };
+    if (nothrow[that.tag]) {
+      this->destroy();
+      this->tag = that.tag;
+      this->move(that);
+      return *this;
+    }
+    using function = add_pointer_t<
+      void(void*, variant_move_function, void*)
+    >;
+    static function const replacers[] = { variant_replace<Ts>... };
+    static variant_move_function const movers[] = { variant_move<Ts>... };
+    replacers[this->tag](this->target(), movers[that.tag], that.target());
+    this->tag = that.tag;
+    return *this;
+  }
+
+  void const* target () const noexcept { return as_void(this->data); }
+  void* target () noexcept { return as_void(this->data); }
+
+  void copy (variant_storage const& that) {
+    using function = add_pointer_t<void(void*, void const*)>;
+    static function const callers[] = { variant_copy<Ts>... };
+    callers[this->tag](this->target(), that.target());
+  }
+
+  void move (variant_storage& that) noexcept(nothrow_move()) {
+    using function = add_pointer_t<void(void*, void*)>;
+    static function const callers[] = { variant_move<Ts>... };
+    callers[this->tag](this->target(), that.target());
+  }
+
+  void destroy () noexcept {
+    using function = add_pointer_t<void(void*)>;
+    static function const callers[] = { variant_destroy<Ts>... };
+    callers[this->tag](this->target());
+  }
+
+  storage_type data;
+  ::std::size_t tag;
+};
+
+/* When every alternative is trivially copyable and trivially destructible,
+ * the variant is too. This permits memcpy, register passing, and bulk
+ * relocation within containers.
+ */
+template <class... Ts>
+struct variant_storage<meta::list<Ts...>, true> {
+  using storage_type = aligned_union_t<0, Ts...>;
+
+  explicit variant_storage (::std::size_t tag) noexcept :
+    data { },
+    tag { tag }
+  { }
+
+  void const* target () const noexcept { return as_void(this->data); }
+  void* target () noexcept { return as_void(this->data); }
+
+  void destroy () noexcept { }
+
+  storage_type data;
+  ::std::size_t tag;
+};
+
 }}} /* namespace core::v2::impl */
 
 namespace core {
@@ -98,8 +443,12 @@ struct bad_variant_get final : ::std::logic_error {
 [[noreturn]] inline void throw_bad_variant_get () {
   throw bad_variant_get { "incorrect type" };
 }
+[[noreturn]] inline void throw_variant_vector_length () {
+  throw ::std::length_error { "variant_vector alternative is full" };
+}
 #else /* CORE_NO_EXCEPTIONS */
 [[noreturn]] inline void throw_bad_variant_get () { ::std::abort(); }
+[[noreturn]] inline void throw_variant_vector_length () { ::std::abort(); }
 #endif /* CORE_NO_EXCEPTIONS */
 
 template <::std::size_t> struct emplace_index_t { };
@@ -119,40 +468,17 @@ template <class T> struct emplace_type_t { };
  * calls visit with a generate overload<Lambdas...> type.
  */
 template <class... Ts>
-class variant final {
+class variant final : private impl::variant_storage<meta::list<Ts...>> {
   using typelist = meta::list<Ts...>;
+  using base = impl::variant_storage<typelist>;
 
   //static_assert(meta::all<(meta::count<typelist, Ts>() == 1)...>(), "");
   static_assert(meta::none_of<typelist, ::std::is_reference>(), "");
   static_assert(meta::none_of<typelist, ::std::is_void>(), "");
 
-  using storage_type = aligned_union_t<0, Ts...>;
-
   template <::std::size_t N> using size = meta::integral<::std::size_t, N>;
   template <::std::size_t N> using element = meta::get<typelist, N>;
 
-  struct copier final {
-    using data_type = add_pointer_t<void>;
-    data_type data;
-
-    template <class T>
-    void operator ()(T const& value) const { ::new (this->data) T(value); }
-  };
-
-  struct mover final {
-    using data_type = add_pointer_t<void>;
-    data_type data;
-
-    template <class T>
-    void operator () (T&& value) {
-      ::new (this->data) decay_t<T>(::core::move(value));
-    }
-  };
-
-  struct destroyer final {
-    template <class T> void operator ()(T const& value) const { value.~T(); }
-  };
-
   struct swapper final {
     using data_type = add_pointer_t<void>;
     data_type data;
@@ -210,7 +536,7 @@ class variant final {
     class=enable_if_t<N < typelist::size()>,
     class T
   > explicit variant (size<N>&&, ::std::true_type&&, T&& value) :
-    data { }, tag { N }
+    base { N }
   { ::new (this->target()) element<N> (::core::forward<T>(value)); }
 
   template <class T>
@@ -251,8 +577,7 @@ public:
     meta::require<meta::count<typelist, T>() == 1> = __LINE__,
     meta::require<::std::is_constructible<T, Args...>::value> = __LINE__
   > variant (emplace_type_t<T>, Args&&... args) :
-    data { },
-    tag { meta::index_of<typelist, T>() }
+    base { meta::index_of<typelist, T>() }
   { ::new (this->target()) T(::core::forward<Args>(args)...); }
 
   template <
@@ -263,41 +588,57 @@ public:
       ::std::is_constructible<element<I>, Args...>::value
     > = __LINE__
   > variant (emplace_index_t<I>, Args&&... args) :
-    data { },
-    tag { I }
+    base { I }
   { ::new (this->target()) element<I>(::core::forward<Args>(args)...); }
 
-  variant (variant const& that) :
-    data { },
-    tag { that.tag }
-  { that.visit(copier { this->target() }); }
-
-  variant (variant&& that) noexcept :
-    data { }, tag { that.tag }
-  { that.visit(mover { this->target() }); }
-
+  variant (variant const&) = default;
+  variant (variant&&) = default;
   variant () : variant { element<0> { } } { }
+  ~variant () = default;
 
-  ~variant () { this->visit(destroyer { }); }
-
+  /* If T is exactly one of the variant's types and that type is currently
+   * held, the value is assigned directly instead of being reconstructed.
+   */
   template <
     class T,
     meta::inhibit<::std::is_same<decay_t<T>, variant>::value> = __LINE__
   > variant& operator = (T&& value) {
-    variant { ::core::forward<T>(value) }.swap(*this);
+    this->assign(
+      select_index<T> { },
+      assignable<T> { },
+      ::core::forward<T>(value)
+    );
     return *this;
   }
 
-  variant& operator = (variant const& that) {
-    variant { that }.swap(*this);
-    return *this;
+  variant& operator = (variant const&) = default;
+  variant& operator = (variant&&) = default;
+
+  template <
+    ::std::size_t I,
+    class... Args,
+    meta::require<I < typelist::size()> = __LINE__,
+    meta::require<
+      ::std::is_constructible<element<I>, Args...>::value
+    > = __LINE__
+  > element<I>& emplace (Args&&... args) {
+    this->replace(
+      size<I> { },
+      ::std::is_nothrow_constructible<element<I>, Args...> { },
+      ::core::forward<Args>(args)...
+    );
+    return *this->template cast<I>();
   }
 
-  variant& operator = (variant&& that) noexcept {
-    this->visit(destroyer { });
-    this->tag = that.tag;
-    that.visit(mover { this->target() });
-    return *this;
+  template <
+    class T,
+    class... Args,
+    meta::require<meta::count<typelist, T>() == 1> = __LINE__,
+    meta::require<::std::is_constructible<T, Args...>::value> = __LINE__
+  > T& emplace (Args&&... args) {
+    return this->template emplace<meta::index_of<typelist, T>()>(
+      ::core::forward<Args>(args)...
+    );
   }
 
   /* Placing these inside of the variant results in no implicit conversions
@@ -335,12 +676,8 @@ public:
       meta::list<add_lvalue_reference_t<Ts>...>,
       Args...
     >;
-    using function = add_pointer_t<return_type(V&&, void*, Args&&...)>;
-    static auto const callers = make_array(
-      impl::gen<V, Ts, void, function, Args...>()...
-    );
-
-    return callers[this->tag](
+    return impl::visit_strategy<return_type, Ts...>::call(
+      this->tag,
       ::core::forward<V>(visitor),
       this->target(),
       ::core::forward<Args>(args)...
@@ -355,13 +692,8 @@ public:
     using return_type = impl::result_t<
       V, meta::list<add_lvalue_reference_t<add_const_t<Ts>>...>, Args...
     >;
-
-    using function = add_pointer_t<return_type(V&&, void const*, Args&&...)>;
-    static auto const callers = make_array(
-      impl::gen<V, add_const_t<Ts>, void const, function, Args...>()...
-    );
-
-    return callers[this->tag](
+    return impl::visit_strategy<return_type, add_const_t<Ts>...>::call(
+      this->tag,
       ::core::forward<V>(visitor),
       this->target(),
       ::core::forward<Args>(args)...
@@ -400,11 +732,65 @@ public:
   bool empty () const noexcept { return false; }
 
 private:
-  void const* target () const noexcept { return as_void(this->data); }
-  void* target () noexcept { return as_void(this->data); }
+  template <class T>
+  using assignable = meta::boolean<
+    meta::count<typelist, decay_t<T>>() == 1 and
+    ::std::is_assignable<
+      add_lvalue_reference_t<element<select_index<T>::value>>,
+      T
+    >::value
+  >;
 
-  storage_type data;
-  ::std::size_t tag;
+  template <::std::size_t N, class T>
+  void assign (size<N>, ::std::true_type, T&& value) {
+    if (this->index() == N) {
+      *this->template cast<N>() = ::core::forward<T>(value);
+      return;
+    }
+    this->assign(size<N> { }, ::std::false_type { }, ::core::forward<T>(value));
+  }
+
+  template <::std::size_t N, class T>
+  void assign (size<N>, ::std::false_type, T&& value) {
+    variant { ::core::forward<T>(value) }.swap(*this);
+  }
+
+  /* construction cannot fail, so the storage is reused directly */
+  template <::std::size_t N, class... Args>
+  void replace (size<N>, ::std::true_type, Args&&... args) noexcept {
+    this->destroy();
+    ::new (this->target()) element<N>(::core::forward<Args>(args)...);
+    this->tag = N;
+  }
+
+  /* construct aside first, so the variant is never left without a value */
+  template <::std::size_t N, class... Args>
+  void replace (size<N>, ::std::false_type, Args&&... args) {
+    this->replace_aside(
+      size<N> { },
+      ::std::is_nothrow_move_constructible<element<N>> { },
+      ::core::forward<Args>(args)...
+    );
+  }
+
+  /* moving the temporary into place cannot fail */
+  template <::std::size_t N, class... Args>
+  void replace_aside (size<N>, ::std::true_type, Args&&... args) {
+    element<N> temp(::core::forward<Args>(args)...);
+    this->replace(size<N> { }, ::std::true_type { }, ::core::move(temp));
+  }
+
+  /* the move might throw, so it must not happen after destroy() */
+  template <::std::size_t N, class... Args>
+  void replace_aside (size<N>, ::std::false_type, Args&&... args) {
+    variant {
+      emplace_index_t<N> { },
+      ::core::forward<Args>(args)...
+    }.swap(*this);
+  }
+
+  using base::destroy;
+  using base::target;
 };
 
 template <class... Ts>
@@ -491,6 +877,285 @@ auto get (variant<Ts...>& v) noexcept(false) -> meta::unless<
   decltype(get<meta::index_of<meta::list<Ts...>, T>()>(v))
 > { return get<meta::index_of<meta::list<Ts...>, T>()>(v); }
 
+/* A sequence of variant values stored as a structure of arrays. Each
+ * element's discriminator is kept in a dense byte array, alongside an offset
+ * into a contiguous array holding only the values of that alternative. This
+ * removes the per-element padding of a vector<variant<Ts...>> and permits
+ * visiting every value of a single alternative without branching. Offsets are
+ * 32 bits wide, limiting each alternative to 2^32 values.
+ */
+template <class... Ts>
+struct variant_vector final {
+  using typelist = meta::list<Ts...>;
+
+  static_assert(typelist::size() > 0, "variant_vector requires a type");
+  static_assert(
+    typelist::size() <= ::std::numeric_limits<::std::uint8_t>::max() + 1u,
+    "variant_vector discriminators are limited to 256 types"
+  );
+
+  template <::std::size_t N> using element = meta::get<typelist, N>;
+  template <::std::size_t N>
+  using storage = impl::variant_vector_slot_t<element<N>>;
+
+  using value_type = variant<Ts...>;
+  using size_type = ::std::size_t;
+  using index_type = ::std::uint8_t;
+  using offset_type = ::std::uint32_t;
+
+  variant_vector (variant_vector const&) = default;
+  variant_vector (variant_vector&&) = default;
+  variant_vector () = default;
+
+  variant_vector& operator = (variant_vector const&) = default;
+  variant_vector& operator = (variant_vector&&) = default;
+
+  void push_back (value_type const& value) {
+    this->push(value, index_sequence_for<Ts...> { });
+  }
+
+  void push_back (value_type&& value) {
+    this->push(::core::move(value), index_sequence_for<Ts...> { });
+  }
+
+  template <
+    ::std::size_t I,
+    class... Args,
+    meta::require<I < typelist::size()> = __LINE__,
+    meta::require<
+      ::std::is_constructible<element<I>, Args...>::value
+    > = __LINE__
+  > element<I>& emplace_back (Args&&... args) {
+    this->reserve_next();
+    auto& values = ::std::get<I>(this->values);
+    if (values.size() > ::std::numeric_limits<offset_type>::max()) {
+      throw_variant_vector_length();
+    }
+    values.emplace_back(::core::forward<Args>(args)...);
+    this->offsets.push_back(static_cast<offset_type>(values.size() - 1));
+    this->tags.push_back(static_cast<index_type>(I));
+    return impl::variant_vector_value(values.back());
+  }
+
+  template <
+    class T,
+    class... Args,
+    meta::require<meta::count<typelist, T>() == 1> = __LINE__,
+    meta::require<::std::is_constructible<T, Args...>::value> = __LINE__
+  > T& emplace_back (Args&&... args) {
+    return this->template emplace_back<meta::index_of<typelist, T>()>(
+      ::core::forward<Args>(args)...
+    );
+  }
+
+  void pop_back () {
+    this->pop(index_sequence_for<Ts...> { });
+    this->offsets.pop_back();
+    this->tags.pop_back();
+  }
+
+  void reserve (size_type n) {
+    this->offsets.reserve(n);
+    this->tags.reserve(n);
+  }
+
+  void clear () noexcept {
+    this->clear(index_sequence_for<Ts...> { });
+    this->offsets.clear();
+    this->tags.clear();
+  }
+
+  size_type size () const noexcept { return this->tags.size(); }
+  bool empty () const noexcept { return this->tags.empty(); }
+
+  /* the discriminator of each element, in insertion order */
+  index_type const* indices () const noexcept { return this->tags.data(); }
+  size_type index (size_type idx) const noexcept { return this->tags[idx]; }
+
+  /* returns a copy, as elements are not stored as variants */
+  value_type operator [] (size_type idx) const {
+    return this->visit(idx, impl::variant_vector_loader<value_type> { });
+  }
+
+  template <::std::size_t I>
+  add_pointer_t<add_const_t<element<I>>> get (size_type idx) const noexcept {
+    if (this->index(idx) != I) { return nullptr; }
+    return ::std::addressof(this->template value<I>(this->offsets[idx]));
+  }
+
+  template <::std::size_t I>
+  add_pointer_t<element<I>> get (size_type idx) noexcept {
+    if (this->index(idx) != I) { return nullptr; }
+    return ::std::addressof(this->template value<I>(this->offsets[idx]));
+  }
+
+  /* all values of a single alternative, contiguous and in insertion order */
+  template <::std::size_t I>
+  ::std::vector<storage<I>> const& alternative () const noexcept {
+    return ::std::get<I>(this->values);
+  }
+
+  template <::std::size_t I, class F>
+  void for_each (F&& f) {
+    for (auto& value : ::std::get<I>(this->values)) {
+      f(impl::variant_vector_value(value));
+    }
+  }
+
+  template <::std::size_t I, class F>
+  void for_each (F&& f) const {
+    for (auto& value : ::std::get<I>(this->values)) {
+      f(impl::variant_vector_value(value));
+    }
+  }
+
+  /* V stands for Visitor */
+  template <class V, class... Args>
+  auto visit (size_type idx, V&& visitor, Args&&... args) -> common_type_t<
+    result_of_t<V(add_lvalue_reference_t<Ts>, Args...)>...
+  > {
+    using return_type = impl::result_t<
+      V,
+      meta::list<add_lvalue_reference_t<Ts>...>,
+      Args...
+    >;
+    return impl::visit_strategy<return_type, Ts...>::call(
+      this->index(idx),
+      ::core::forward<V>(visitor),
+      this->target(idx, index_sequence_for<Ts...> { }),
+      ::core::forward<Args>(args)...
+    );
+  }
+
+  /* V stands for Visitor */
+  template <class V, class... Args>
+  auto visit (
+    size_type idx,
+    V&& visitor,
+    Args&&... args
+  ) const -> common_type_t<
+    result_of_t<V(add_lvalue_reference_t<add_const_t<Ts>>, Args...)>...
+  > {
+    using return_type = impl::result_t<
+      V, meta::list<add_lvalue_reference_t<add_const_t<Ts>>...>, Args...
+    >;
+    return impl::visit_strategy<return_type, add_const_t<Ts>...>::call(
+      this->index(idx),
+      ::core::forward<V>(visitor),
+      this->target(idx, index_sequence_for<Ts...> { }),
+      ::core::forward<Args>(args)...
+    );
+  }
+
+  template <class... Vs>
+  auto match (size_type idx, Vs&&... vs) -> decltype(
+    this->visit(idx, impl::make_overload(::core::forward<Vs>(vs)...))
+  ) {
+    return this->visit(idx, impl::make_overload(::core::forward<Vs>(vs)...));
+  }
+
+  template <class... Vs>
+  auto match (size_type idx, Vs&&... vs) const -> decltype(
+    this->visit(idx, impl::make_overload(::core::forward<Vs>(vs)...))
+  ) {
+    return this->visit(idx, impl::make_overload(::core::forward<Vs>(vs)...));
+  }
+
+  void swap (variant_vector& that) noexcept {
+    using ::std::swap;
+    swap(this->values, that.values);
+    swap(this->offsets, that.offsets);
+    swap(this->tags, that.tags);
+  }
+
+private:
+  /* reserve geometrically so that no push can fail after the value is in */
+  void reserve_next () {
+    if (this->tags.size() < this->tags.capacity() and
+        this->offsets.size() < this->offsets.capacity()) { return; }
+    auto const size = this->size();
+    this->reserve(size ? size * 2 : 8);
+  }
+
+  template <::std::size_t I>
+  void push_copy (value_type const& value) {
+    this->template emplace_back<I>(*::core::get<I>(::std::addressof(value)));
+  }
+
+  template <::std::size_t I>
+  void push_move (value_type& value) {
+    this->template emplace_back<I>(
+      ::core::move(*::core::get<I>(::std::addressof(value)))
+    );
+  }
+
+  template <::std::size_t... Is>
+  void push (value_type const& value, index_sequence<Is...>) {
+    using function = void (variant_vector::*)(value_type const&);
+    static function const callers[] = { &variant_vector::push_copy<Is>... };
+    (this->*callers[value.index()])(value);
+  }
+
+  template <::std::size_t... Is>
+  void push (value_type&& value, index_sequence<Is...>) {
+    using function = void (variant_vector::*)(value_type&);
+    static function const callers[] = { &variant_vector::push_move<Is>... };
+    (this->*callers[value.index()])(value);
+  }
+
+  template <::std::size_t I> void pop_value () {
+    ::std::get<I>(this->values).pop_back();
+  }
+
+  template <::std::size_t... Is> void pop (index_sequence<Is...>) {
+    using function = void (variant_vector::*)();
+    static function const callers[] = { &variant_vector::pop_value<Is>... };
+    (this->*callers[this->tags.back()])();
+  }
+
+  template <::std::size_t... Is> void clear (index_sequence<Is...>) noexcept {
+    int expand[] = { (::std::get<Is>(this->values).clear(), 0)... };
+    (void)expand;
+  }
+
+  template <::std::size_t I>
+  element<I> const& value (offset_type offset) const noexcept {
+    return impl::variant_vector_value(::std::get<I>(this->values)[offset]);
+  }
+
+  template <::std::size_t I> element<I>& value (offset_type offset) noexcept {
+    return impl::variant_vector_value(::std::get<I>(this->values)[offset]);
+  }
+
+  template <::std::size_t I> void* address (offset_type offset) noexcept {
+    return as_void(this->template value<I>(offset));
+  }
+
+  template <::std::size_t... Is>
+  void* target (size_type idx, index_sequence<Is...>) noexcept {
+    using function = void* (variant_vector::*)(offset_type);
+    static function const callers[] = { &variant_vector::address<Is>... };
+    return (this->*callers[this->index(idx)])(this->offsets[idx]);
+  }
+
+  template <::std::size_t... Is>
+  void const* target (
+    size_type idx,
+    index_sequence<Is...> seq
+  ) const noexcept {
+    return const_cast<variant_vector*>(this)->target(idx, seq);
+  }
+
+  ::std::tuple<::std::vector<impl::variant_vector_slot_t<Ts>>...> values;
+  ::std::vector<offset_type> offsets;
+  ::std::vector<index_type> tags;
+};
+
+template <class... Ts>
+void swap (variant_vector<Ts...>& lhs, variant_vector<Ts...>& rhs) noexcept {
+  lhs.swap(rhs);
+}
+
 }} /* namespace core::v2 */
 
 namespace std {
@@ -1,4 +1,5 @@
 #include <core/algorithm.hpp>
+#include <core/string_view.hpp>
 #include <initializer_list>
 #include <random>
 #include <vector>
@@ -135,6 +136,17 @@ TEST_CASE("search", "[non-modifying-sequence]") {
     CHECK(result != end(value));
   }
 
+  SECTION("searcher") {
+    auto value = std::string { "searching with the search function" };
+    auto searcher = core::make_two_way_searcher(core::string_view { "the" });
+    auto result = core::search(value, searcher);
+    CHECK(std::distance(begin(value), result) == 15);
+    auto missing = core::make_boyer_moore_horspool_searcher(
+      core::string_view { "needle" }
+    );
+    CHECK(core::search(value, missing) == end(value));
+  }
+
   SECTION("search-n") {
     auto value = std::string { "searching for consecutive letters" };
     auto result = core::search_n(value, 2, 't');
@@ -0,0 +1,338 @@
+#include <core/charconv.hpp>
+
+#include <limits>
+#include <random>
+#include <string>
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <cstdio>
+#include <cmath>
+
+#include "catch.hpp"
+
+TEST_CASE("from-chars-integer", "[charconv]") {
+  SECTION("decimal") {
+    auto value = core::from_chars<int>("12345 rest");
+    REQUIRE(value);
+    CHECK(value->value == 12345);
+    CHECK(value->count == 5u);
+  }
+
+  SECTION("negative") {
+    auto value = core::from_chars<long>("-42");
+    REQUIRE(value);
+    CHECK(value->value == -42);
+    CHECK(value->count == 3u);
+    CHECK_FALSE(core::from_chars<unsigned>("-42"));
+  }
+
+  SECTION("invalid") {
+    CHECK_FALSE(core::from_chars<int>(""));
+    CHECK_FALSE(core::from_chars<int>("-"));
+    CHECK_FALSE(core::from_chars<int>("+1"));
+    CHECK_FALSE(core::from_chars<int>(" 1"));
+    auto value = core::from_chars<int>("x");
+    CHECK(value.condition() == std::errc::invalid_argument);
+  }
+
+  SECTION("leading-zeros") {
+    auto value = core::from_chars<std::uint64_t>(
+      "0000000000000000000000000018446744073709551615"
+    );
+    REQUIRE(value);
+    CHECK(value->value == std::numeric_limits<std::uint64_t>::max());
+    CHECK(value->count == 46u);
+  }
+
+  SECTION("limits") {
+    auto min = core::from_chars<std::int64_t>("-9223372036854775808");
+    auto max = core::from_chars<std::int64_t>("9223372036854775807");
+    REQUIRE(min);
+    REQUIRE(max);
+    CHECK(min->value == std::numeric_limits<std::int64_t>::min());
+    CHECK(max->value == std::numeric_limits<std::int64_t>::max());
+    CHECK(core::from_chars<std::int8_t>("-128")->value == -128);
+  }
+
+  SECTION("out-of-range") {
+    auto value = core::from_chars<std::int8_t>("128");
+    CHECK(value.condition() == std::errc::result_out_of_range);
+    CHECK_FALSE(core::from_chars<std::int64_t>("9223372036854775808"));
+    CHECK_FALSE(core::from_chars<std::uint64_t>("18446744073709551616"));
+    CHECK_FALSE(core::from_chars<std::uint64_t>("99999999999999999999"));
+  }
+
+  SECTION("base") {
+    CHECK(core::from_chars<int>("ff", 16)->value == 255);
+    CHECK(core::from_chars<int>("FF", 16)->value == 255);
+    CHECK(core::from_chars<int>("-101", 2)->value == -5);
+    CHECK(core::from_chars<int>("zz", 36)->value == 1295);
+    auto partial = core::from_chars<int>("129", 8);
+    REQUIRE(partial);
+    CHECK(partial->value == 10);
+    CHECK(partial->count == 2u);
+    CHECK_FALSE(core::from_chars<int>("0x10", 16)->value);
+    CHECK_FALSE(core::from_chars<int>("1", 37));
+  }
+
+  SECTION("random") {
+    std::mt19937_64 engine { 7 };
+    for (auto i = 0; i < 100000; ++i) {
+      auto const expected = static_cast<std::int64_t>(engine()) >> (i % 64);
+      auto const str = std::to_string(expected);
+      auto const value = core::from_chars<std::int64_t>(str);
+      REQUIRE(value);
+      CHECK(value->value == expected);
+      CHECK(value->count == str.size());
+    }
+  }
+}
+
+TEST_CASE("from-chars-floating-point", "[charconv]") {
+  SECTION("decimal") {
+    auto value = core::from_chars<double>("3.25e2,");
+    REQUIRE(value);
+    CHECK(value->value == 325.0);
+    CHECK(value->count == 6u);
+    CHECK(core::from_chars<double>(".5")->value == 0.5);
+    CHECK(core::from_chars<double>("5.")->value == 5.0);
+    CHECK(core::from_chars<float>("-0.125")->value == -0.125f);
+  }
+
+  SECTION("exponent-not-consumed") {
+    auto value = core::from_chars<double>("1e+");
+    REQUIRE(value);
+    CHECK(value->value == 1.0);
+    CHECK(value->count == 1u);
+  }
+
+  SECTION("invalid") {
+    CHECK_FALSE(core::from_chars<double>(""));
+    CHECK_FALSE(core::from_chars<double>("."));
+    CHECK_FALSE(core::from_chars<double>("-"));
+    CHECK_FALSE(core::from_chars<double>("+1"));
+    CHECK_FALSE(core::from_chars<double>("e5"));
+  }
+
+  SECTION("special") {
+    auto inf = core::from_chars<double>("-Infinity");
+    REQUIRE(inf);
+    CHECK(std::isinf(inf->value));
+    CHECK(inf->value < 0);
+    CHECK(inf->count == 9u);
+    CHECK(core::from_chars<double>("infx")->count == 3u);
+    auto nan = core::from_chars<float>("nan(payload_1)");
+    REQUIRE(nan);
+    CHECK(std::isnan(nan->value));
+    CHECK(nan->count == 14u);
+    CHECK(core::from_chars<double>("nan(")->count == 3u);
+  }
+
+  SECTION("zero") {
+    auto zero = core::from_chars<double>("-0.0e10");
+    REQUIRE(zero);
+    CHECK(zero->value == 0.0);
+    CHECK(std::signbit(zero->value));
+  }
+
+  SECTION("limits") {
+    auto max = core::from_chars<double>("1.7976931348623157e308");
+    auto min = core::from_chars<double>("4.9406564584124654e-324");
+    REQUIRE(max);
+    REQUIRE(min);
+    CHECK(max->value == std::numeric_limits<double>::max());
+    CHECK(min->value == std::numeric_limits<double>::denorm_min());
+    auto overflow = core::from_chars<double>("1e309");
+    CHECK(overflow.condition() == std::errc::result_out_of_range);
+    CHECK_FALSE(core::from_chars<double>("1e-400"));
+    CHECK_FALSE(core::from_chars<float>("1e39"));
+  }
+
+  SECTION("long-significand") {
+    auto value = core::from_chars<double>(
+      "123456789012345678901234567890.000000000000000000000000001"
+    );
+    REQUIRE(value);
+    CHECK(value->value == 123456789012345678901234567890.0);
+    /* halfway between 1 and the next double, plus a little */
+    auto above = core::from_chars<double>(
+      "1.00000000000000011102230246251565404236316680908203126"
+    );
+    REQUIRE(above);
+    CHECK(above->value == std::nextafter(1.0, 2.0));
+    auto exact = core::from_chars<double>(
+      "1.00000000000000011102230246251565404236316680908203125"
+    );
+    REQUIRE(exact);
+    CHECK(exact->value == 1.0);
+  }
+
+  SECTION("bounded-fallback") {
+    /* halfway between 1 and the next double, with the deciding digit placed
+     * far past the digits kept by the fallback
+     */
+    std::string const halfway {
+      "-1.00000000000000011102230246251565404236316680908203125"
+    };
+    auto const zeros = std::string(1000, '0');
+    auto const above_str = halfway + zeros + "1e0";
+    auto const exact_str = halfway + zeros + "e0";
+    auto const above = core::from_chars<double>(above_str);
+    auto const exact = core::from_chars<double>(exact_str);
+    REQUIRE(above);
+    REQUIRE(exact);
+    CHECK(above->value == -std::nextafter(1.0, 2.0));
+    CHECK(above->count == above_str.size());
+    CHECK(exact->value == -1.0);
+    auto const scaled_str = "1" + zeros + "1.5e-1001";
+    auto const scaled = core::from_chars<double>(scaled_str);
+    REQUIRE(scaled);
+    CHECK(scaled->value == std::strtod(scaled_str.c_str(), nullptr));
+  }
+
+  SECTION("round-trip") {
+    std::mt19937_64 engine { 11 };
+    char buffer[64];
+    for (auto i = 0; i < 100000; ++i) {
+      double expected;
+      auto const bits = engine();
+      std::memcpy(&expected, &bits, sizeof(expected));
+      if (not std::isfinite(expected)) { continue; }
+      std::snprintf(buffer, sizeof(buffer), "%.17g", expected);
+      auto const value = core::from_chars<double>(buffer);
+      REQUIRE(value);
+      CHECK(value->value == expected);
+      CHECK(value->count == std::strlen(buffer));
+    }
+  }
+
+  SECTION("strtod") {
+    std::mt19937_64 engine { 13 };
+    std::string str;
+    for (auto i = 0; i < 100000; ++i) {
+      str.clear();
+      auto const length = 1 + engine() % 30;
+      for (auto n = 0u; n < length; ++n) {
+        str += static_cast<char>('0' + engine() % 10);
+      }
+      str.insert(engine() % str.size(), ".");
+      str += "e" + std::to_string(static_cast<int>(engine() % 400) - 200);
+      auto const value = core::from_chars<double>(str);
+      REQUIRE(value);
+      CHECK(value->value == std::strtod(str.c_str(), nullptr));
+    }
+  }
+}
+
+TEST_CASE("to-chars-integer", "[charconv]") {
+  char buffer[80];
+  auto const end = buffer + sizeof(buffer);
+
+  SECTION("decimal") {
+    CHECK(core::to_chars(buffer, end, 0) == "0");
+    CHECK(core::to_chars(buffer, end, 7) == "7");
+    CHECK(core::to_chars(buffer, end, 42) == "42");
+    CHECK(core::to_chars(buffer, end, -1234567) == "-1234567");
+    CHECK(core::to_chars(buffer, end, 100u) == "100");
+  }
+
+  SECTION("limits") {
+    auto const min = std::numeric_limits<std::int64_t>::min();
+    auto const max = std::numeric_limits<std::uint64_t>::max();
+    CHECK(core::to_chars(buffer, end, min) == "-9223372036854775808");
+    CHECK(core::to_chars(buffer, end, max) == "18446744073709551615");
+    auto const small = std::numeric_limits<std::int8_t>::min();
+    CHECK(core::to_chars(buffer, end, small) == "-128");
+  }
+
+  SECTION("base") {
+    CHECK(core::to_chars(buffer, end, 255, 16) == "ff");
+    CHECK(core::to_chars(buffer, end, -5, 2) == "-101");
+    CHECK(core::to_chars(buffer, end, 1295, 36) == "zz");
+    CHECK(core::to_chars(buffer, end, 0, 8) == "0");
+  }
+
+  SECTION("too-small") {
+    CHECK(core::to_chars(buffer, buffer + 3, 1234).empty());
+    CHECK(core::to_chars(buffer, buffer + 3, -123).empty());
+    CHECK(core::to_chars(buffer, buffer + 3, 123) == "123");
+    CHECK(core::to_chars(buffer, buffer + 2, 8, 2).empty());
+  }
+
+  SECTION("round-trip") {
+    std::mt19937_64 engine { 17 };
+    for (auto i = 0; i < 100000; ++i) {
+      auto const expected = static_cast<std::int64_t>(engine()) >> (i % 64);
+      auto const str = core::to_chars(buffer, end, expected);
+      CHECK(str == std::to_string(expected));
+    }
+  }
+}
+
+TEST_CASE("to-chars-floating-point", "[charconv]") {
+  char buffer[32];
+  auto const end = buffer + sizeof(buffer);
+
+  SECTION("shortest") {
+    CHECK(core::to_chars(buffer, end, 0.1) == "0.1");
+    CHECK(core::to_chars(buffer, end, 0.3) == "0.3");
+    CHECK(core::to_chars(buffer, end, 1.5) == "1.5");
+    CHECK(core::to_chars(buffer, end, 100.0) == "100");
+    CHECK(core::to_chars(buffer, end, -2.0) == "-2");
+    CHECK(core::to_chars(buffer, end, 1e23) == "1e+23");
+    CHECK(core::to_chars(buffer, end, 0.1 + 0.2) == "0.30000000000000004");
+  }
+
+  SECTION("notation") {
+    CHECK(core::to_chars(buffer, end, 123456.0) == "123456");
+    CHECK(core::to_chars(buffer, end, 1e6) == "1e+06");
+    CHECK(core::to_chars(buffer, end, 0.001) == "0.001");
+    CHECK(core::to_chars(buffer, end, 1e-5) == "1e-05");
+    CHECK(core::to_chars(buffer, end, 1.25e-7) == "1.25e-07");
+    CHECK(core::to_chars(buffer, end, 1.5e300) == "1.5e+300");
+  }
+
+  SECTION("special") {
+    auto const inf = std::numeric_limits<double>::infinity();
+    auto const nan = std::numeric_limits<double>::quiet_NaN();
+    CHECK(core::to_chars(buffer, end, 0.0) == "0");
+    CHECK(core::to_chars(buffer, end, -0.0) == "-0");
+    CHECK(core::to_chars(buffer, end, inf) == "inf");
+    CHECK(core::to_chars(buffer, end, -inf) == "-inf");
+    CHECK(core::to_chars(buffer, end, nan) == "nan");
+  }
+
+  SECTION("limits") {
+    auto const max = std::numeric_limits<double>::max();
+    auto const min = std::numeric_limits<double>::min();
+    auto const denorm = std::numeric_limits<double>::denorm_min();
+    CHECK(core::to_chars(buffer, end, max) == "1.7976931348623157e+308");
+    CHECK(core::to_chars(buffer, end, min) == "2.2250738585072014e-308");
+    CHECK(core::to_chars(buffer, end, denorm) == "5e-324");
+    CHECK(core::to_chars(buffer, end, -min).size() == 24u);
+  }
+
+  SECTION("too-small") {
+    CHECK(core::to_chars(buffer, buffer + 2, 0.5).empty());
+    CHECK(core::to_chars(buffer, buffer + 3, 0.5) == "0.5");
+    CHECK(core::to_chars(buffer, buffer + 2, -0.0) == "-0");
+  }
+
+  SECTION("round-trip") {
+    std::mt19937_64 engine { 19 };
+    for (auto i = 0; i < 100000; ++i) {
+      double expected;
+      auto const bits = engine();
+      std::memcpy(&expected, &bits, sizeof(expected));
+      if (not std::isfinite(expected)) { continue; }
+      auto const str = core::to_chars(buffer, end, expected);
+      REQUIRE_FALSE(str.empty());
+      auto const value = core::from_chars<double>(str);
+      REQUIRE(value);
+      CHECK(value->value == expected);
+      CHECK(value->count == str.size());
+    }
+  }
+}
@@ -0,0 +1,141 @@
+#include <core/chunk_reader.hpp>
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <cstdio>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "catch.hpp"
+
+namespace {
+
+std::vector<std::string> read_lines (
+  std::string const& text,
+  std::size_t size=core::chunk_reader::default_size
+) {
+  std::istringstream stream { text };
+  core::chunk_reader reader { stream, size };
+  std::vector<std::string> lines;
+  for (auto line : reader.lines()) { lines.push_back(line.to_string()); }
+  return lines;
+}
+
+} /* namespace */
+
+TEST_CASE("chunk-reader-chunks", "[chunk-reader][chunks]") {
+  SECTION("empty") {
+    std::istringstream stream { "" };
+    core::chunk_reader reader { stream };
+    auto chunks = reader.chunks();
+    CHECK(chunks.begin() == chunks.end());
+  }
+
+  SECTION("small-buffer") {
+    std::string text(1000, 'a');
+    text[500] = 'b';
+    std::istringstream stream { text };
+    core::chunk_reader reader { stream.rdbuf(), 64 };
+    std::string result;
+    std::size_t count = 0;
+    for (auto chunk : reader.chunks()) {
+      CHECK(chunk.size() <= 64u);
+      result.append(chunk.data(), chunk.size());
+      ++count;
+    }
+    CHECK(count == 16u);
+    CHECK(result == text);
+  }
+
+  SECTION("after-lines") {
+    std::istringstream stream { "first\nsecond\nthird" };
+    core::chunk_reader reader { stream };
+    core::string_view line;
+    CHECK(reader.next_line(line));
+    CHECK(line == "first");
+    CHECK(reader.next_chunk() == "second\nthird");
+    CHECK(reader.next_chunk().empty());
+    CHECK_FALSE(reader.next_line(line));
+  }
+
+  SECTION("file-descriptor") {
+    char const* path = "core-chunk-reader-test.txt";
+    std::string text(100000, 'x');
+    {
+      auto file = std::fopen(path, "wb");
+      std::fwrite(text.data(), 1, text.size(), file);
+      std::fclose(file);
+    }
+    auto fd = ::open(path, O_RDONLY);
+    REQUIRE(fd >= 0);
+    std::string result;
+    {
+      core::chunk_reader reader { fd, 4096 };
+      for (auto chunk : reader.chunks()) {
+        result.append(chunk.data(), chunk.size());
+      }
+    }
+    ::close(fd);
+    std::remove(path);
+    CHECK(result == text);
+  }
+}
+
+TEST_CASE("chunk-reader-lines", "[chunk-reader][lines]") {
+  SECTION("empty") {
+    CHECK(read_lines("").empty());
+  }
+
+  SECTION("trailing-line-feed") {
+    auto lines = read_lines("one\ntwo\n");
+    REQUIRE(lines.size() == 2u);
+    CHECK(lines[0] == "one");
+    CHECK(lines[1] == "two");
+  }
+
+  SECTION("no-trailing-line-feed") {
+    auto lines = read_lines("one\n\nthree");
+    REQUIRE(lines.size() == 3u);
+    CHECK(lines[0] == "one");
+    CHECK(lines[1] == "");
+    CHECK(lines[2] == "three");
+  }
+
+  SECTION("across-buffers") {
+    std::string text;
+    std::vector<std::string> expected;
+    for (std::size_t i = 0; i < 200; ++i) {
+      expected.emplace_back(i % 37, static_cast<char>('a' + i % 26));
+      text += expected.back();
+      text += '\n';
+    }
+    CHECK(read_lines(text, 8) == expected);
+    CHECK(read_lines(text, 1) == expected);
+  }
+
+  SECTION("growth") {
+    std::string text(1000, 'z');
+    std::istringstream stream { text + "\nend" };
+    core::chunk_reader reader { stream, 16 };
+    core::string_view line;
+    CHECK(reader.next_line(line));
+    CHECK(line == text);
+    CHECK(reader.buffer_size() >= 1000u);
+    CHECK(reader.next_line(line));
+    CHECK(line == "end");
+    CHECK_FALSE(reader.next_line(line));
+  }
+
+  SECTION("wide") {
+    std::wistringstream stream { L"alpha\nbeta" };
+    core::wchunk_reader reader { stream, 3 };
+    std::vector<std::wstring> lines;
+    for (auto line : reader.lines()) { lines.push_back(line.to_string()); }
+    REQUIRE(lines.size() == 2u);
+    CHECK((lines[0] == L"alpha"));
+    CHECK((lines[1] == L"beta"));
+  }
+}
@@ -0,0 +1,266 @@
+#include <core/inline_string.hpp>
+
+#include <unordered_set>
+#include <type_traits>
+#include <sstream>
+#include <string>
+
+#include "catch.hpp"
+
+namespace {
+
+/* counts allocations so that tests can tell whether a string spilled */
+struct counting_resource final : core::pmr::memory_resource {
+  std::size_t allocations { 0 };
+  std::size_t outstanding { 0 };
+
+private:
+  void* do_allocate (std::size_t bytes, std::size_t alignment) override {
+    ++this->allocations;
+    ++this->outstanding;
+    return core::pmr::new_delete_resource()->allocate(bytes, alignment);
+  }
+
+  void do_deallocate (
+    void* ptr,
+    std::size_t bytes,
+    std::size_t alignment
+  ) override {
+    --this->outstanding;
+    core::pmr::new_delete_resource()->deallocate(ptr, bytes, alignment);
+  }
+
+  bool do_is_equal (
+    core::pmr::memory_resource const& that
+  ) const noexcept override { return this == &that; }
+};
+
+} /* namespace */
+
+TEST_CASE("inline-string-constructors", "[inline-string][constructors]") {
+  SECTION("default-constructor") {
+    core::inline_string<16> str { };
+    CHECK(str.empty());
+    CHECK(str.size() == 0u);
+    CHECK(str.capacity() == 16u);
+    CHECK(*str.c_str() == '\0');
+  }
+
+  SECTION("view-constructor") {
+    core::string_view view { "inline" };
+    core::inline_string<16> str { view };
+    CHECK(str.size() == 6u);
+    CHECK(str == view);
+    CHECK(str.c_str()[6] == '\0');
+  }
+
+  SECTION("pointer-constructor") {
+    core::inline_string<16> str { "key", 2 };
+    CHECK(str == "ke");
+  }
+
+  SECTION("count-constructor") {
+    core::inline_string<16> str(4, 'z');
+    CHECK(str == "zzzz");
+  }
+
+  SECTION("string-constructor") {
+    std::string value { "from std::string" };
+    core::inline_string<16> str { value };
+    CHECK(str == value);
+  }
+
+  SECTION("overflow") {
+    CHECK_THROWS_AS(
+      core::inline_string<4> { "too long" },
+      std::length_error const&
+    );
+  }
+
+  SECTION("trivially-copyable") {
+    CHECK(std::is_trivially_copyable<core::inline_string<40>>::value);
+    CHECK(sizeof(core::inline_string<39>) == 41u);
+  }
+}
+
+TEST_CASE("inline-string-methods", "[inline-string][methods]") {
+  SECTION("append") {
+    core::inline_string<16> str { "abc" };
+    str += "def";
+    str += 'g';
+    str.append(2, 'h');
+    CHECK(str == "abcdefghh");
+    CHECK_THROWS_AS(str.append("too much text"), std::length_error const&);
+    CHECK(str == "abcdefghh");
+  }
+
+  SECTION("append-self") {
+    core::pmr::inline_string<4> str { "abcd" };
+    str.append(str.view());
+    CHECK(str == "abcdabcd");
+    str.append(str.view().substr(2, 3));
+    CHECK(str == "abcdabcdcda");
+  }
+
+  SECTION("assign-self") {
+    core::inline_string<16> str { "prefix-key" };
+    str = str.view().substr(7);
+    CHECK(str == "key");
+  }
+
+  SECTION("erase") {
+    core::inline_string<16> str { "hello world" };
+    str.erase(5, 6);
+    CHECK(str == "hello");
+    str.erase(1);
+    CHECK(str == "h");
+    CHECK_THROWS_AS(str.erase(2), std::out_of_range const&);
+  }
+
+  SECTION("resize") {
+    core::inline_string<16> str { "ab" };
+    str.resize(4, '-');
+    CHECK(str == "ab--");
+    str.resize(1);
+    CHECK(str == "a");
+  }
+
+  SECTION("push-pop") {
+    core::inline_string<16> str { };
+    str.push_back('x');
+    str.push_back('y');
+    str.pop_back();
+    CHECK(str == "x");
+    CHECK(str.back() == 'x');
+  }
+
+  SECTION("at") {
+    core::inline_string<16> str { "abc" };
+    CHECK(str.at(1) == 'b');
+    CHECK_THROWS_AS(str.at(3), std::out_of_range const&);
+  }
+
+  SECTION("iterators") {
+    core::inline_string<16> str { "abc" };
+    std::string reversed { str.rbegin(), str.rend() };
+    CHECK(reversed == "cba");
+    CHECK(std::string(str.begin(), str.end()) == "abc");
+  }
+
+  SECTION("compare") {
+    core::inline_string<8> lhs { "apple" };
+    core::inline_string<16> rhs { "banana" };
+    CHECK(lhs < rhs);
+    CHECK(lhs != rhs);
+    CHECK("apple" == lhs);
+    CHECK(lhs == std::string { "apple" });
+    CHECK(lhs.compare("apple") == 0);
+  }
+
+  SECTION("swap") {
+    core::inline_string<16> lhs { "left" };
+    core::inline_string<16> rhs { "right" };
+    swap(lhs, rhs);
+    CHECK(lhs == "right");
+    CHECK(rhs == "left");
+  }
+
+  SECTION("hash") {
+    std::unordered_set<core::inline_string<16>> set { "a", "b", "a" };
+    CHECK(set.size() == 2u);
+    std::hash<core::inline_string<16>> hash { };
+    std::hash<core::string_view> view_hash { };
+    CHECK(hash("key") == view_hash("key"));
+  }
+
+  SECTION("ostream") {
+    std::ostringstream stream;
+    stream << core::inline_string<16> { "printed" };
+    CHECK(stream.str() == "printed");
+  }
+}
+
+TEST_CASE("inline-string-pmr", "[inline-string][pmr]") {
+  counting_resource resource;
+
+  SECTION("inline") {
+    core::string_view key { "a key of thirty-two characters.." };
+    core::pmr::inline_string<40> str { key, &resource };
+    CHECK(str.size() == 32u);
+    CHECK(resource.allocations == 0u);
+    CHECK(str.get_allocator().resource() == &resource);
+  }
+
+  SECTION("spill") {
+    core::pmr::inline_string<8> str { &resource };
+    str = "short";
+    CHECK(resource.allocations == 0u);
+    str += " and then much longer";
+    CHECK(resource.allocations == 1u);
+    CHECK(str == "short and then much longer");
+    CHECK(str.capacity() >= str.size());
+    str.erase(5);
+    str.shrink_to_fit();
+    CHECK(resource.outstanding == 0u);
+    CHECK(str.capacity() == 8u);
+    CHECK(str == "short");
+  }
+
+  SECTION("copy") {
+    core::pmr::inline_string<8> str { "longer than eight", &resource };
+    auto copy = str;
+    CHECK(copy == str);
+    CHECK(copy.get_allocator().resource() != &resource);
+    CHECK(resource.allocations == 1u);
+    copy = "x";
+    str = copy;
+    CHECK(str == "x");
+  }
+
+  SECTION("move") {
+    core::pmr::inline_string<8> str { "longer than eight", &resource };
+    auto data = str.data();
+    core::pmr::inline_string<8> moved { std::move(str) };
+    CHECK(moved.data() == data);
+    CHECK(str.empty());
+
+    core::pmr::inline_string<8> other { &resource };
+    other = std::move(moved);
+    CHECK(other.data() == data);
+    CHECK(resource.allocations == 1u);
+
+    core::pmr::inline_string<8> foreign { };
+    foreign = std::move(other);
+    CHECK(foreign == "longer than eight");
+    CHECK(foreign.data() != data);
+  }
+
+  SECTION("swap") {
+    core::pmr::inline_string<8> lhs { "a string that spilled", &resource };
+    core::pmr::inline_string<8> rhs { "inline", &resource };
+    lhs.swap(rhs);
+    CHECK(lhs == "inline");
+    CHECK(rhs == "a string that spilled");
+    core::pmr::inline_string<8> foreign { "foreign" };
+    rhs.swap(foreign);
+    CHECK(rhs == "foreign");
+    CHECK(foreign == "a string that spilled");
+    CHECK(rhs.get_allocator().resource() == &resource);
+  }
+
+  SECTION("narrower-than-pointer") {
+    core::pmr::inline_string<2> str { "spilled past two", &resource };
+    core::pmr::inline_string<2> moved { std::move(str) };
+    CHECK(moved == "spilled past two");
+    core::pmr::inline_string<2> other { "ab", &resource };
+    other = std::move(moved);
+    CHECK(other == "spilled past two");
+    core::pmr::inline_string<2> inline_value { "cd", &resource };
+    other.swap(inline_value);
+    CHECK(other == "cd");
+    CHECK(inline_value == "spilled past two");
+    CHECK(resource.allocations == 1u);
+  }
+
+  CHECK(resource.outstanding == 0u);
+}
@@ -0,0 +1,109 @@
+#include <core/intern.hpp>
+
+#include <unordered_set>
+#include <string>
+#include <vector>
+
+#include "catch.hpp"
+
+TEST_CASE("intern-pool", "[intern]") {
+  SECTION("deduplicate") {
+    core::intern_pool pool { };
+    std::string first { "symbol" };
+    std::string second { "symbol" };
+    auto lhs = pool.intern(first);
+    auto rhs = pool.intern(second);
+    CHECK(pool.size() == 1u);
+    CHECK(lhs == rhs);
+    CHECK(lhs.view().data() == rhs.view().data());
+    CHECK(lhs.view().data() != first.data());
+    CHECK(lhs.view() == "symbol");
+    CHECK(std::string { lhs.c_str() } == "symbol");
+    CHECK(lhs != pool.intern("symbols"));
+    CHECK(pool.size() == 2u);
+  }
+
+  SECTION("find") {
+    core::intern_pool pool { };
+    CHECK_FALSE(pool.find("missing"));
+    auto sym = pool.intern("present");
+    CHECK(pool.find("present") == sym);
+    CHECK_FALSE(pool.find("missing"));
+    CHECK(pool.size() == 1u);
+  }
+
+  SECTION("stable") {
+    core::intern_pool pool { };
+    std::vector<core::symbol> symbols;
+    std::vector<char const*> addresses;
+    for (auto i = 0; i < 10000; ++i) {
+      symbols.push_back(pool.intern(std::to_string(i)));
+      addresses.push_back(symbols.back().view().data());
+    }
+    CHECK(pool.size() == 10000u);
+    for (auto i = 0; i < 10000; ++i) {
+      auto const str = std::to_string(i);
+      auto const sym = pool.intern(str);
+      CHECK(sym == symbols[i]);
+      CHECK(sym.view().data() == addresses[i]);
+      CHECK(sym.id() == static_cast<std::size_t>(i));
+      CHECK(pool[sym.id()] == sym);
+    }
+    CHECK(pool.size() == 10000u);
+  }
+
+  SECTION("empty-string") {
+    core::intern_pool pool { };
+    auto sym = pool.intern("");
+    CHECK(sym);
+    CHECK(sym.empty());
+    CHECK(pool.intern(core::string_view { }) == sym);
+    CHECK(sym != core::symbol { });
+  }
+
+  SECTION("ordering") {
+    core::intern_pool pool { };
+    auto b = pool.intern("b");
+    auto a = pool.intern("a");
+    core::symbol null { };
+    CHECK(b < a);
+    CHECK(null < b);
+    CHECK_FALSE(b < null);
+    CHECK(a >= b);
+    CHECK(null <= null);
+  }
+
+  SECTION("hash") {
+    core::intern_pool pool { };
+    std::unordered_set<core::symbol> set;
+    set.insert(pool.intern("x"));
+    set.insert(pool.intern("y"));
+    set.insert(pool.intern("x"));
+    CHECK(set.size() == 2u);
+    CHECK(set.count(pool.find("y")) == 1u);
+  }
+
+  SECTION("clear") {
+    core::intern_pool pool { };
+    pool.intern("one");
+    pool.intern("two");
+    pool.clear();
+    CHECK(pool.empty());
+    CHECK_FALSE(pool.find("one"));
+    CHECK(pool.intern("two").id() == 0u);
+  }
+
+  SECTION("wide") {
+    core::u32intern_pool pool { };
+    auto sym = pool.intern(U"\U0001F600");
+    CHECK(pool.intern(std::u32string { U"\U0001F600" }) == sym);
+    CHECK(sym.size() == 1u);
+  }
+
+  SECTION("upstream") {
+    core::intern_pool pool { core::pmr::new_delete_resource() };
+    CHECK(pool.resource() == core::pmr::new_delete_resource());
+    pool.reserve(100);
+    CHECK(pool.intern("value").view() == "value");
+  }
+}
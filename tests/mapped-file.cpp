@@ -0,0 +1,120 @@
+#include <core/mapped_file.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <string>
+
+#include <cstdio>
+
+#include "catch.hpp"
+
+namespace {
+
+struct temporary_file final {
+  explicit temporary_file (std::string const& content) :
+    path { "core-mapped-file-test.txt" }
+  {
+    std::ofstream stream { path, std::ios::binary };
+    stream << content;
+  }
+
+  ~temporary_file () { std::remove(path.c_str()); }
+
+  std::string path;
+};
+
+} /* namespace */
+
+TEST_CASE("mapped-file-constructors", "[mapped-file][constructors]") {
+  SECTION("default-constructor") {
+    core::mapped_file file { };
+    CHECK_FALSE(file);
+    CHECK(file.empty());
+    CHECK(file.size() == 0u);
+    CHECK(file.view().empty());
+  }
+
+  SECTION("path-constructor") {
+    temporary_file temp { "hello, mapped world" };
+    core::mapped_file file { temp.path };
+    CHECK(file);
+    CHECK(file.size() == 19u);
+    CHECK(file.view() == "hello, mapped world");
+  }
+
+  SECTION("empty-file") {
+    temporary_file temp { "" };
+    core::mapped_file file { temp.path };
+    CHECK_FALSE(file);
+    CHECK(file.empty());
+  }
+
+  SECTION("missing-file") {
+    CHECK_THROWS_AS(
+      core::mapped_file { "core-mapped-file-missing.txt" },
+      std::system_error const&
+    );
+    core::mapped_file file { };
+    auto error = file.open("core-mapped-file-missing.txt");
+    CHECK(error);
+    CHECK_FALSE(file);
+  }
+
+  SECTION("move-constructor") {
+    temporary_file temp { "moved" };
+    core::mapped_file file { temp.path };
+    core::mapped_file moved { std::move(file) };
+    CHECK_FALSE(file);
+    CHECK(moved.view() == "moved");
+  }
+
+  SECTION("move-assignment") {
+    temporary_file temp { "assigned" };
+    core::mapped_file file { temp.path };
+    core::mapped_file other { };
+    other = std::move(file);
+    CHECK_FALSE(file);
+    CHECK(other.view() == "assigned");
+  }
+}
+
+TEST_CASE("mapped-file-methods", "[mapped-file][methods]") {
+  std::string content(10000, 'x');
+  content[9999] = 'y';
+  temporary_file temp { content };
+
+  SECTION("bytes") {
+    core::mapped_file file { temp.path };
+    auto bytes = file.bytes();
+    CHECK(bytes.size() == 10000u);
+    auto count = std::count(bytes.begin(), bytes.end(), 'x');
+    CHECK(count == 9999);
+    CHECK(bytes.back() == 'y');
+  }
+
+  SECTION("iterators") {
+    core::mapped_file file { temp.path };
+    CHECK(std::string(file.begin(), file.end()) == content);
+  }
+
+  SECTION("close") {
+    core::mapped_file file { temp.path };
+    file.close();
+    CHECK_FALSE(file);
+    CHECK(file.empty());
+  }
+
+  SECTION("advise") {
+    core::mapped_file file { temp.path, core::mapped_file::advice::sequential };
+    CHECK(file.view() == content);
+    CHECK(file.advise(core::mapped_file::advice::willneed, 4097, 10));
+    CHECK_FALSE(file.advise(core::mapped_file::advice::willneed, 10000));
+  }
+
+  SECTION("huge-pages") {
+    core::mapped_file file { temp.path, core::mapped_file::advice::huge_pages };
+    auto offset = reinterpret_cast<std::uintptr_t>(file.data()) % (1u << 21);
+    CHECK(offset == 0u);
+    CHECK(file.view() == content);
+  }
+}
@@ -1,7 +1,107 @@
 #include <core/memory_resource.hpp>
 
+#include <functional>
+#include <cstdint>
+#include <vector>
+
 #include "catch.hpp"
 
+namespace {
+
+struct counting_resource : core::pmr::memory_resource {
+  std::size_t allocations { 0 };
+  std::size_t deallocations { 0 };
+  std::size_t bytes { 0 };
+
+private:
+  void* do_allocate (std::size_t size, std::size_t alignment) override {
+    ++this->allocations;
+    this->bytes += size;
+    return core::pmr::new_delete_resource()->allocate(size, alignment);
+  }
+
+  void do_deallocate (void* p, std::size_t size, std::size_t align) override {
+    ++this->deallocations;
+    this->bytes -= size;
+    core::pmr::new_delete_resource()->deallocate(p, size, align);
+  }
+
+  bool do_is_equal (
+    core::pmr::memory_resource const& that
+  ) const noexcept override { return this == &that; }
+};
+
+} /* nameless namespace */
+
 TEST_CASE("dummy") {
   CHECK(true);
 }
+
+TEST_CASE("monotonic-buffer-resource", "[memory-resource]") {
+  SECTION("alignment") {
+    core::pmr::monotonic_buffer_resource resource { };
+    for (std::size_t align = 1; align <= 64; align *= 2) {
+      resource.allocate(1, 1);
+      auto ptr = resource.allocate(24, align);
+      auto const offset = reinterpret_cast<std::uintptr_t>(ptr) % align;
+      CHECK(offset == 0u);
+    }
+  }
+
+  SECTION("initial-buffer") {
+    alignas(16) char buffer[256];
+    counting_resource upstream { };
+    core::pmr::monotonic_buffer_resource resource {
+      buffer,
+      sizeof(buffer),
+      &upstream
+    };
+    auto first = resource.allocate(100);
+    auto const begin = static_cast<void*>(buffer);
+    auto const end = static_cast<void*>(buffer + sizeof(buffer));
+    CHECK(std::less_equal<void*> { }(begin, first));
+    CHECK(std::less<void*> { }(first, end));
+    CHECK(upstream.allocations == 0u);
+    resource.allocate(200);
+    CHECK(upstream.allocations == 1u);
+    resource.release();
+    CHECK(upstream.deallocations == 1u);
+    CHECK(resource.allocate(100) == first);
+  }
+
+  SECTION("geometric-growth") {
+    counting_resource upstream { };
+    {
+      core::pmr::monotonic_buffer_resource resource { 64, &upstream };
+      CHECK(resource.upstream_resource() == &upstream);
+      for (auto i = 0; i < 4096; ++i) { resource.allocate(16); }
+      CHECK(upstream.allocations < 16u);
+      resource.deallocate(resource.allocate(8), 8);
+      CHECK(upstream.deallocations == 0u);
+    }
+    CHECK(upstream.deallocations == upstream.allocations);
+    CHECK(upstream.bytes == 0u);
+  }
+
+  SECTION("release-resets-growth") {
+    counting_resource upstream { };
+    core::pmr::monotonic_buffer_resource resource { 64, &upstream };
+    for (auto i = 0; i < 100; ++i) {
+      for (auto j = 0; j < 100; ++j) { resource.allocate(16); }
+      resource.release();
+    }
+    resource.allocate(16);
+    CHECK(upstream.bytes <= 128u);
+  }
+
+  SECTION("allocator") {
+    core::pmr::monotonic_buffer_resource resource { };
+    std::vector<int, core::pmr::polymorphic_allocator<int>> values {
+      core::pmr::polymorphic_allocator<int> { &resource }
+    };
+    for (auto i = 0; i < 1000; ++i) { values.push_back(i); }
+    CHECK(values[999] == 999);
+    CHECK(resource == resource);
+    CHECK(resource != *core::pmr::new_delete_resource());
+  }
+}
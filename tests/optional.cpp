@@ -1,11 +1,13 @@
 #include <core/optional.hpp>
 
 #include <unordered_map>
+#include <stdexcept>
 #include <utility>
 #include <string>
 #include <array>
 
 #include <cstdint>
+#include <cstring>
 
 #include "catch.hpp"
 
@@ -220,6 +222,40 @@ TEST_CASE("optional-methods", "[optional][methods]") {
     CHECK(opt);
     CHECK(*opt == 4);
   }
+
+  SECTION("map") {
+    core::optional<std::string> opt { "map" };
+    core::optional<std::string> empty { };
+    auto size = [](std::string const& str) { return str.size(); };
+
+    CHECK(opt.map(size) == std::size_t { 3 });
+    CHECK_FALSE(empty.map(size));
+    auto moved = core::move(opt).map([](std::string&& str) {
+      return core::move(str) + "ped";
+    });
+    CHECK(moved == std::string { "mapped" });
+  }
+
+  SECTION("and-then") {
+    core::optional<int> opt { 4 };
+    auto half = [](int value) {
+      return value % 2
+        ? core::optional<int> { }
+        : core::make_optional(value / 2);
+    };
+
+    CHECK(opt.and_then(half) == 2);
+    CHECK_FALSE(opt.and_then(half).and_then(half).and_then(half));
+  }
+
+  SECTION("or-else") {
+    core::optional<int> opt { 4 };
+    core::optional<int> empty { };
+    auto fallback = [] { return core::optional<int> { 8 }; };
+
+    CHECK(opt.or_else(fallback) == 4);
+    CHECK(empty.or_else(fallback) == 8);
+  }
 }
 
 TEST_CASE("optional-functions", "[optional][functions]") {
@@ -459,6 +495,281 @@ TEST_CASE("constexpr-operators", "[constexpr][operators]") {
   }
 }
 
+TEST_CASE("optional-traits", "[optional][traits]") {
+  SECTION("optional") {
+    using trivial = core::optional<int>;
+    using nontrivial = core::optional<std::string>;
+
+    static_assert(std::is_trivially_copyable<trivial>::value, "");
+    static_assert(std::is_trivially_copy_constructible<trivial>::value, "");
+    static_assert(std::is_trivially_move_constructible<trivial>::value, "");
+    static_assert(std::is_trivially_copy_assignable<trivial>::value, "");
+    static_assert(std::is_trivially_move_assignable<trivial>::value, "");
+
+    static_assert(not std::is_trivially_copyable<nontrivial>::value, "");
+    static_assert(std::is_nothrow_move_constructible<nontrivial>::value, "");
+    static_assert(std::is_copy_assignable<nontrivial>::value, "");
+  }
+
+  SECTION("expected") {
+    using trivial = core::expected<int, std::errc>;
+    using nontrivial = core::expected<std::string, std::errc>;
+    using pointer = core::expected<int>;
+
+    static_assert(std::is_trivially_copyable<trivial>::value, "");
+    static_assert(std::is_trivially_destructible<trivial>::value, "");
+    static_assert(not std::is_trivially_copyable<nontrivial>::value, "");
+    static_assert(not std::is_trivially_copyable<pointer>::value, "");
+    static_assert(std::is_nothrow_move_constructible<nontrivial>::value, "");
+  }
+
+  SECTION("result") {
+    using trivial = core::result<int>;
+    using nontrivial = core::result<std::string>;
+
+    static_assert(std::is_trivially_copyable<trivial>::value, "");
+    static_assert(std::is_trivially_destructible<trivial>::value, "");
+    static_assert(not std::is_trivially_copyable<nontrivial>::value, "");
+    static_assert(std::is_copy_assignable<nontrivial>::value, "");
+  }
+
+  SECTION("memcpy") {
+    core::optional<int> source { 4 };
+    core::optional<int> target { };
+    core::result<int> error { std::errc::invalid_argument };
+    core::result<int> value { 4 };
+
+    std::memcpy(&target, &source, sizeof(target));
+    std::memcpy(&value, &error, sizeof(value));
+
+    CHECK(target == 4);
+    CHECK_FALSE(value);
+    CHECK(value == make_error_condition(std::errc::invalid_argument));
+  }
+
+  SECTION("assignment") {
+    core::optional<std::string> engaged { "engaged" };
+    core::optional<std::string> empty { };
+    auto copy = engaged;
+
+    copy = empty;
+    CHECK_FALSE(copy);
+    copy = engaged;
+    CHECK(copy == std::string { "engaged" });
+    copy = core::move(empty);
+    CHECK_FALSE(copy);
+  }
+}
+
+TEST_CASE("optional-reference", "[optional][reference]") {
+  using reference = core::optional<std::string&>;
+  static_assert(sizeof(reference) == sizeof(std::string*), "");
+  static_assert(std::is_trivially_copyable<reference>::value, "");
+  static_assert(
+    not std::is_constructible<
+      core::optional<std::string const&>,
+      std::string&&
+    >::value,
+    ""
+  );
+
+  std::string value { "value" };
+
+  SECTION("constructors") {
+    reference empty { };
+    reference engaged { value };
+    core::optional<std::string const&> converted { engaged };
+
+    CHECK_FALSE(empty);
+    CHECK(engaged);
+    CHECK(&*engaged == &value);
+    CHECK(&*converted == &value);
+  }
+
+  SECTION("assignment") {
+    std::string other { "other" };
+    reference opt { value };
+    opt = reference { other };
+    CHECK(value == "value");
+    CHECK(&*opt == &other);
+    opt = core::nullopt;
+    CHECK_FALSE(opt);
+  }
+
+  SECTION("modify") {
+    reference opt { value };
+    *opt = "modified";
+    opt->append("!");
+    CHECK(value == "modified!");
+  }
+
+  SECTION("operators") {
+    std::string other { "value" };
+    reference lhs { value };
+    reference rhs { other };
+
+    CHECK(lhs == rhs);
+    CHECK(lhs == std::string { "value" });
+    CHECK(lhs != std::string { "other" });
+    CHECK(reference { } == core::nullopt);
+  }
+
+  SECTION("methods") {
+    reference opt { value };
+    reference empty { };
+
+    CHECK(&opt.value() == &value);
+    CHECK(empty.value_or("default") == "default");
+    CHECK(opt.value_or("default") == "value");
+    CHECK(opt.map([](std::string const& str) {
+      return str.size();
+    }) == std::size_t { 5 });
+
+    auto size = opt.map(&std::string::size);
+    auto same = opt.map([](std::string& str) -> std::string& { return str; });
+    static_assert(
+      std::is_same<decltype(same), core::optional<std::string&>>::value,
+      ""
+    );
+    CHECK(size == std::size_t { 5 });
+    CHECK(&*same == &value);
+    CHECK(&*empty.or_else([&] { return opt; }) == &value);
+  }
+
+#ifndef CORE_NO_EXCEPTIONS
+  SECTION("value") {
+    reference empty { };
+    CHECK_THROWS_AS(empty.value(), core::bad_optional_access);
+  }
+#endif /* CORE_NO_EXCEPTIONS */
+
+  SECTION("hash") {
+    reference opt { value };
+    CHECK(std::hash<reference> { }(opt) == std::hash<std::string> { }(value));
+  }
+}
+
+namespace {
+
+struct identifier { std::int64_t value; };
+
+struct identifier_traits {
+  static constexpr identifier empty () noexcept { return identifier { -1 }; }
+  static constexpr bool is_empty (identifier const& id) noexcept {
+    return id.value < 0;
+  }
+};
+
+/* const member makes this copy constructible, but not assignable */
+struct handle {
+  explicit handle (int value, bool fail=false) : value { value } {
+#ifndef CORE_NO_EXCEPTIONS
+    if (fail) { throw std::runtime_error { "handle" }; }
+#endif /* CORE_NO_EXCEPTIONS */
+    (void)fail;
+  }
+  int const value;
+};
+
+struct handle_traits {
+  static handle empty () noexcept { return handle { -1 }; }
+  static bool is_empty (handle const& h) noexcept { return h.value < 0; }
+};
+
+} /* nameless namespace */
+
+TEST_CASE("compact-optional", "[compact-optional]") {
+  using sentinel = core::sentinel<std::int64_t, -1>;
+  using integer = core::compact_optional<std::int64_t, sentinel>;
+
+  SECTION("size") {
+    static_assert(sizeof(integer) == sizeof(std::int64_t), "");
+    static_assert(sizeof(core::compact_optional<int*>) == sizeof(int*), "");
+    static_assert(sizeof(core::compact_optional<double>) == sizeof(double), "");
+    static_assert(std::is_trivially_copyable<integer>::value, "");
+  }
+
+  SECTION("sentinel") {
+    constexpr integer disengaged { };
+    constexpr integer engaged { 42 };
+    static_assert(not disengaged, "");
+    static_assert(engaged, "");
+    static_assert(*engaged == 42, "");
+
+    integer value { -1 };
+    CHECK_FALSE(value);
+    value = 7;
+    CHECK(value);
+    CHECK(value == std::int64_t { 7 });
+    value = core::nullopt;
+    CHECK(value == core::nullopt);
+    CHECK(value.value_or(3) == 3);
+  }
+
+  SECTION("pointer") {
+    int target = 4;
+    core::compact_optional<int*> pointer { };
+    CHECK_FALSE(pointer);
+    pointer = &target;
+    CHECK(pointer);
+    CHECK(**pointer == 4);
+  }
+
+  SECTION("nan") {
+    core::compact_optional<double> real { };
+    CHECK_FALSE(real);
+    real.emplace(1.5);
+    CHECK(real);
+    CHECK(real.value() == 1.5);
+  }
+
+  SECTION("custom") {
+    using optional = core::compact_optional<identifier, identifier_traits>;
+    static_assert(sizeof(optional) == sizeof(identifier), "");
+    optional id { };
+    CHECK_FALSE(id);
+    id = identifier { 9 };
+    CHECK(id);
+    CHECK(id->value == 9);
+  }
+
+  SECTION("emplace") {
+    using optional = core::compact_optional<handle, handle_traits>;
+    static_assert(not std::is_copy_assignable<handle>::value, "");
+    optional h { };
+    CHECK_FALSE(h);
+    h.emplace(3);
+    CHECK(h);
+    CHECK(h->value == 3);
+    h.emplace(5);
+    CHECK(h->value == 5);
+#ifndef CORE_NO_EXCEPTIONS
+    CHECK_THROWS_AS(h.emplace(7, true), std::runtime_error const&);
+    CHECK_FALSE(h);
+#endif /* CORE_NO_EXCEPTIONS */
+  }
+
+  SECTION("operators") {
+    integer lhs { 1 };
+    integer rhs { 2 };
+    integer none { };
+
+    CHECK(lhs != rhs);
+    CHECK(lhs < rhs);
+    CHECK(none < lhs);
+    CHECK_FALSE(lhs < none);
+    CHECK(none == integer { });
+    CHECK(std::hash<integer> { }(lhs) == std::hash<std::int64_t> { }(1));
+  }
+
+#ifndef CORE_NO_EXCEPTIONS
+  SECTION("value") {
+    integer none { };
+    CHECK_THROWS_AS(none.value(), core::bad_optional_access);
+  }
+#endif /* CORE_NO_EXCEPTIONS */
+}
+
 #ifndef CORE_NO_EXCEPTIONS
 TEST_CASE("expected-constructors", "[expected][constructors]") {
   SECTION("copy-value") {
@@ -657,6 +968,24 @@ TEST_CASE("expected-method-value-or", "[expected][methods]") {
   CHECK(third == "value-or");
 }
 
+TEST_CASE("expected-method-map", "[expected][methods]") {
+  auto ptr = std::make_exception_ptr(std::logic_error { "" });
+  core::expected<std::string> value { "map" };
+  core::expected<std::string> error { ptr };
+  auto size = [](std::string const& str) { return str.size(); };
+  auto fallback = [](std::exception_ptr) {
+    return core::expected<std::string> { "fallback" };
+  };
+
+  CHECK(value.map(size) == std::size_t { 3 });
+  CHECK(error.map(size).pointer() == ptr);
+  CHECK(*value.and_then([](std::string const& str) {
+    return core::make_expected(str + "ped");
+  }) == "mapped");
+  CHECK(*error.or_else(fallback) == "fallback");
+  CHECK(*value.or_else(fallback) == "map");
+}
+
 TEST_CASE("expected-method-value", "[expected][methods]") {
   auto ptr = std::make_exception_ptr(std::logic_error { "" });
   core::expected<std::string> value { ptr };
@@ -955,6 +1284,82 @@ TEST_CASE("result-method-value-or", "[result][methods]") {
   CHECK(error.value_or("error") == "error");
 }
 
+TEST_CASE("result-method-map", "[result][methods]") {
+  using result = core::result<std::string>;
+  auto const condition = make_error_condition(std::errc::permission_denied);
+  result value { "map" };
+  result error { condition };
+  auto append = [](std::string&& str) { return core::move(str) + "ped"; };
+  auto recover = [](std::error_condition const&) { return result { "" }; };
+
+  CHECK(core::move(value).map(append) == std::string { "mapped" });
+  CHECK(core::move(error).map(append) == condition);
+  CHECK(error.and_then([](std::string const& str) {
+    return result { str };
+  }) == condition);
+  CHECK(error.or_else(recover) == std::string { });
+}
+
+namespace {
+
+/* counts how often it is copied and moved */
+struct counted {
+  static int copies;
+  static int moves;
+
+  explicit counted (int value) : value { value } { }
+  counted (counted const& that) : value { that.value } { ++copies; }
+  counted (counted&& that) noexcept : value { that.value } { ++moves; }
+
+  counted& operator = (counted const& that) {
+    this->value = that.value;
+    ++copies;
+    return *this;
+  }
+
+  counted& operator = (counted&& that) noexcept {
+    this->value = that.value;
+    ++moves;
+    return *this;
+  }
+
+  int value;
+};
+
+int counted::copies = 0;
+int counted::moves = 0;
+
+} /* nameless namespace */
+
+TEST_CASE("result-method-map-rvalue", "[result][methods]") {
+  auto increment = [](counted&& item) {
+    ++item.value;
+    return core::move(item);
+  };
+  core::result<counted> value { counted { 0 } };
+  counted::copies = 0;
+  counted::moves = 0;
+
+  auto const mapped = core::move(value)
+    .map(increment)
+    .map(increment)
+    .map(increment)
+    .map(increment)
+    .map(increment);
+
+  REQUIRE(mapped);
+  CHECK(mapped->value == 5);
+  CHECK(counted::copies == 0);
+  CHECK(counted::moves > 0);
+
+  core::optional<counted> opt { counted { 0 } };
+  counted::copies = 0;
+  auto const chained = core::move(opt).map(increment).map(increment);
+  REQUIRE(chained);
+  CHECK(chained->value == 2);
+  CHECK(counted::copies == 0);
+}
+
 TEST_CASE("result-method-value", "[result][methods]") {
   core::result<std::string> value { "value" };
   core::result<std::string> thrower { std::errc::permission_denied };
@@ -1151,6 +1556,181 @@ TEST_CASE("expected-void-function-swap", "[expected][void][functions]") {
 }
 #endif /* CORE_NO_EXCDEPTIONS */
 
+TEST_CASE("expected-error-constructors", "[expected][error][constructors]") {
+  using expected = core::expected<std::string, std::errc>;
+  SECTION("default") {
+    expected value { };
+    CHECK(value);
+    CHECK(value->empty());
+  }
+
+  SECTION("value") {
+    expected value { std::string { "value" } };
+    CHECK(value);
+    CHECK(*value == "value");
+  }
+
+  SECTION("unexpected") {
+    expected value { core::make_unexpected(std::errc::permission_denied) };
+    CHECK_FALSE(value);
+    CHECK(value.error() == std::errc::permission_denied);
+  }
+
+  SECTION("copy") {
+    expected value { std::string { "copy" } };
+    expected error { core::make_unexpected(std::errc::invalid_argument) };
+    expected value_copy { value };
+    expected error_copy { error };
+    CHECK(value_copy);
+    CHECK(*value_copy == "copy");
+    CHECK_FALSE(error_copy);
+    CHECK(error_copy.error() == std::errc::invalid_argument);
+  }
+
+  SECTION("move") {
+    expected value { std::string { "move" } };
+    expected move { core::move(value) };
+    CHECK(move);
+    CHECK(*move == "move");
+  }
+}
+
+TEST_CASE("expected-error-assignment", "[expected][error][assignment]") {
+  using expected = core::expected<std::string, std::error_code>;
+  auto const code = make_error_code(std::errc::permission_denied);
+
+  SECTION("value-to-error") {
+    expected value { std::string { "value" } };
+    value = core::make_unexpected(code);
+    CHECK_FALSE(value);
+    CHECK(value.error() == code);
+  }
+
+  SECTION("error-to-value") {
+    expected value { core::make_unexpected(code) };
+    value = std::string { "value" };
+    CHECK(value);
+    CHECK(*value == "value");
+  }
+
+  SECTION("copy") {
+    expected value { std::string { "value" } };
+    expected error { core::make_unexpected(code) };
+    value = error;
+    CHECK_FALSE(value);
+    CHECK(value.error() == code);
+  }
+}
+
+TEST_CASE("expected-error-operators", "[expected][error][operators]") {
+  using expected = core::expected<int, std::errc>;
+  auto const unexpected = core::make_unexpected(std::errc::invalid_argument);
+  expected lhs_valid { 4 };
+  expected rhs_valid { 4 };
+  expected lhs_invalid { unexpected };
+  expected rhs_invalid { unexpected };
+
+  CHECK(lhs_valid == rhs_valid);
+  CHECK(lhs_invalid == rhs_invalid);
+  CHECK(lhs_valid != lhs_invalid);
+  CHECK(lhs_valid == 4);
+  CHECK(lhs_valid != 5);
+  CHECK(lhs_invalid == unexpected);
+  CHECK(lhs_valid != unexpected);
+}
+
+TEST_CASE("expected-error-methods", "[expected][error][methods]") {
+  using expected = core::expected<int, std::errc>;
+  expected valid { 7 };
+  expected invalid { core::make_unexpected(std::errc::invalid_argument) };
+
+  SECTION("value-or") {
+    CHECK(valid.value_or(3) == 7);
+    CHECK(invalid.value_or(3) == 3);
+  }
+
+  SECTION("emplace") {
+    invalid.emplace(9);
+    CHECK(invalid);
+    CHECK(*invalid == 9);
+  }
+
+  SECTION("map") {
+    auto twice = [](int value) { return value * 2; };
+    CHECK(valid.map(twice) == 14);
+    CHECK(invalid.map(twice).error() == std::errc::invalid_argument);
+  }
+
+  SECTION("and-then") {
+    auto reject = [](int) -> expected {
+      return core::make_unexpected(std::errc::result_out_of_range);
+    };
+    CHECK(valid.and_then(reject).error() == std::errc::result_out_of_range);
+    CHECK(invalid.and_then(reject).error() == std::errc::invalid_argument);
+  }
+
+  SECTION("or-else") {
+    auto recover = [](std::errc) { return expected { 0 }; };
+    CHECK(valid.or_else(recover) == 7);
+    CHECK(invalid.or_else(recover) == 0);
+  }
+
+#ifndef CORE_NO_EXCEPTIONS
+  SECTION("value") {
+    using access = core::bad_expected_access<std::errc>;
+    CHECK(valid.value() == 7);
+    CHECK_THROWS_AS(invalid.value(), access);
+    try { invalid.value(); }
+    catch (access const& e) {
+      CHECK(e.error() == std::errc::invalid_argument);
+    }
+  }
+
+  SECTION("error") {
+    CHECK_THROWS_AS(valid.error(), core::bad_expected_type);
+  }
+#endif /* CORE_NO_EXCEPTIONS */
+}
+
+TEST_CASE("expected-error-function-swap", "[expected][error][functions]") {
+  using std::swap;
+  using expected = core::expected<std::string, int>;
+  expected lhs { std::string { "lhs" } };
+  expected rhs { core::make_unexpected(5) };
+
+  swap(lhs, rhs);
+  CHECK_FALSE(lhs);
+  CHECK(lhs.error() == 5);
+  CHECK(rhs);
+  CHECK(*rhs == "lhs");
+
+  swap(lhs, rhs);
+  CHECK(lhs);
+  CHECK_FALSE(rhs);
+}
+
+TEST_CASE("expected-void-error", "[expected][void][error]") {
+  using expected = core::expected<void, std::errc>;
+  auto const unexpected = core::make_unexpected(std::errc::invalid_argument);
+  expected valid { };
+  expected invalid { unexpected };
+
+  CHECK(valid);
+  CHECK_FALSE(invalid);
+  CHECK(invalid.error() == std::errc::invalid_argument);
+  CHECK(valid != invalid);
+  CHECK(invalid == expected { unexpected });
+
+  valid = unexpected;
+  CHECK_FALSE(valid);
+  swap(valid, invalid);
+  CHECK_FALSE(valid);
+  invalid = expected { };
+  swap(valid, invalid);
+  CHECK(valid);
+  CHECK_FALSE(invalid);
+}
+
 TEST_CASE("result-void-constructor", "[result][void][constructors]") {
   core::result<void> value;
   CHECK(value);
@@ -1236,3 +1816,72 @@ TEST_CASE("result-void-method-condition", "[result][void][functions]") {
   CHECK_THROWS_AS(valid.condition(), core::bad_result_condition);
 }
 #endif /* CORE_NO_EXCEPTIONS */
+
+namespace {
+
+struct packet_category final : std::error_category {
+  char const* name () const noexcept override { return "packet"; }
+  std::string message (int) const override { return "packet error"; }
+};
+
+} /* nameless namespace */
+
+TEST_CASE("status-code", "[status][result]") {
+  constexpr core::status_code invalid { std::errc::invalid_argument };
+  static_assert(sizeof(core::status_code) == sizeof(std::uint32_t), "");
+  static_assert(invalid == std::errc::invalid_argument, "");
+  static_assert(invalid != core::status_code { }, "");
+  static_assert(invalid.domain() == core::status_code::generic_domain, "");
+  static_assert(not core::status_code { }, "");
+  using status_result = core::status_result<int>;
+  static_assert(std::is_trivially_copyable<status_result>::value, "");
+  static_assert(sizeof(status_result) == 2 * sizeof(int), "");
+
+  SECTION("condition") {
+    auto const condition = invalid.condition();
+    CHECK(condition == std::errc::invalid_argument);
+    CHECK(&condition.category() == &std::generic_category());
+    CHECK(static_cast<std::error_condition>(invalid) == condition);
+  }
+
+  SECTION("register") {
+    static packet_category const category { };
+    core::status_code code { 42, 7 };
+
+    CHECK(code.domain() == 42u);
+    CHECK(code.value() == 7);
+    CHECK(std::string { code.category().name() } == "core::status");
+    core::register_status_category(42, category);
+    CHECK(&code.condition().category() == &category);
+  }
+
+  SECTION("range") {
+    constexpr core::status_code negative { 42, -5 };
+    static_assert(negative.value() == -5, "");
+    static_assert(negative.domain() == 42u, "");
+    core::status_code lowest { 3, core::status_code::min_value() };
+    core::status_code highest { 3, core::status_code::max_value() };
+    core::status_code minus_one { 3, -1 };
+    CHECK(lowest.value() == -0x800000);
+    CHECK(highest.value() == 0x7FFFFF);
+    CHECK(minus_one.value() == -1);
+    CHECK(minus_one.domain() == 3u);
+    CHECK(minus_one);
+  }
+
+  SECTION("result") {
+    status_result value { 4 };
+    status_result error { core::make_unexpected(invalid) };
+
+    CHECK(*value == 4);
+    CHECK_FALSE(error);
+    CHECK(error.error() == std::errc::invalid_argument);
+    CHECK(error == core::make_unexpected(invalid));
+  }
+
+  SECTION("hash") {
+    std::hash<core::status_code> hash { };
+    core::status_code copy { std::errc::invalid_argument };
+    CHECK(hash(invalid) == hash(copy));
+  }
+}
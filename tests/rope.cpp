@@ -0,0 +1,250 @@
+#include <core/rope.hpp>
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include <sys/uio.h>
+
+#include "catch.hpp"
+
+namespace {
+
+/* tracks outstanding allocations so that tests can tell which resource a
+ * rope returned its memory to
+ */
+struct tracking_resource final : core::pmr::memory_resource {
+  std::size_t outstanding { 0 };
+
+private:
+  void* do_allocate (std::size_t bytes, std::size_t alignment) override {
+    this->outstanding += bytes;
+    return core::pmr::new_delete_resource()->allocate(bytes, alignment);
+  }
+
+  void do_deallocate (
+    void* ptr,
+    std::size_t bytes,
+    std::size_t alignment
+  ) override {
+    this->outstanding -= bytes;
+    core::pmr::new_delete_resource()->deallocate(ptr, bytes, alignment);
+  }
+
+  bool do_is_equal (
+    core::pmr::memory_resource const& that
+  ) const noexcept override { return this == &that; }
+};
+
+} /* namespace */
+
+TEST_CASE("rope-constructors", "[rope][constructors]") {
+  SECTION("default-constructor") {
+    core::rope rope { };
+    CHECK(rope.empty());
+    CHECK(rope.size() == 0u);
+    CHECK(rope.segments().empty());
+    CHECK(rope.begin() == rope.end());
+  }
+
+  SECTION("move-constructor") {
+    core::rope rope { };
+    rope.append_copy("owned");
+    core::rope moved { std::move(rope) };
+    CHECK(rope.empty());
+    CHECK(moved == "owned");
+  }
+
+  SECTION("move-assignment") {
+    core::rope rope { };
+    rope.append_copy("first");
+    core::rope other { };
+    other.append_copy("second");
+    other = std::move(rope);
+    CHECK(other == "first");
+  }
+
+  SECTION("move-assignment-unequal-resources") {
+    tracking_resource left;
+    tracking_resource right;
+    {
+      core::rope source { &left };
+      source.append_copy("owned ").append("borrowed");
+      core::rope target { &right };
+      target.append_copy("replaced");
+      target = std::move(source);
+      CHECK(source.empty());
+      CHECK(target == "owned borrowed");
+      CHECK(target.resource() == &right);
+      source.append_copy("reused");
+      CHECK(source == "reused");
+    }
+    CHECK(left.outstanding == 0u);
+    CHECK(right.outstanding == 0u);
+  }
+
+  SECTION("swap-unequal-resources") {
+    tracking_resource left;
+    tracking_resource right;
+    {
+      core::rope lhs { &left };
+      lhs.append_copy("left");
+      core::rope rhs { &right };
+      rhs.append("right ").append_copy("side");
+      swap(lhs, rhs);
+      CHECK(lhs == "right side");
+      CHECK(rhs == "left");
+      CHECK(lhs.resource() == &left);
+      CHECK(rhs.resource() == &right);
+      lhs.append_copy("!");
+      CHECK(lhs == "right side!");
+    }
+    CHECK(left.outstanding == 0u);
+    CHECK(right.outstanding == 0u);
+  }
+}
+
+TEST_CASE("rope-methods", "[rope][methods]") {
+  SECTION("append") {
+    core::rope rope { };
+    rope.append("HTTP/1.1 200 OK\r\n").append("").append("\r\n");
+    CHECK(rope.size() == 19u);
+    CHECK(rope.segments().size() == 2u);
+    CHECK(rope.to_string() == "HTTP/1.1 200 OK\r\n\r\n");
+  }
+
+  SECTION("append-copy") {
+    core::rope rope { };
+    {
+      std::string temporary { "temporary" };
+      rope.append_copy(temporary);
+      rope.append_copy(temporary);
+    }
+    CHECK(rope == "temporarytemporary");
+    CHECK(rope.segments().size() == 1u);
+  }
+
+  SECTION("merge-adjacent") {
+    core::string_view text { "adjacent views" };
+    core::rope rope { };
+    rope.append(text.substr(0, 8)).append(text.substr(8));
+    CHECK(rope.segments().size() == 1u);
+    CHECK(rope == text);
+  }
+
+  SECTION("append-rope") {
+    core::rope head { };
+    head.append("head ");
+    core::rope body { };
+    body.append_copy("body");
+    head.append(body);
+    CHECK(head == "head body");
+    head.append(head);
+    CHECK(head == "head bodyhead body");
+  }
+
+  SECTION("iteration") {
+    core::rope rope { };
+    rope.append("ab").append("c").append("de");
+    std::string result { rope.begin(), rope.end() };
+    CHECK(result == "abcde");
+  }
+
+  SECTION("copy") {
+    core::rope rope { };
+    rope.append("abc").append("def").append("ghi");
+    char buffer[9] { };
+    CHECK(rope.copy(buffer, 4, 2) == 4u);
+    CHECK(std::string(buffer, 4) == "cdef");
+    CHECK(rope.copy(buffer, 100, 7) == 2u);
+    CHECK(std::string(buffer, 2) == "hi");
+    CHECK_THROWS_AS(rope.copy(buffer, 1, 10), std::out_of_range const&);
+  }
+
+  SECTION("find") {
+    core::rope rope { };
+    rope.append("Content-").append("Le").append("ngth: 42");
+    CHECK(rope.find("Content") == 0u);
+    CHECK(rope.find("Length") == 8u);
+    CHECK(rope.find("-Length:") == 7u);
+    CHECK(rope.find("42") == 16u);
+    CHECK(rope.find("43") == core::rope::npos);
+    CHECK(rope.find("t", 4) == 6u);
+    CHECK(rope.find("") == 0u);
+    CHECK(rope.find('L') == 8u);
+    CHECK(rope.find('n', 10) == 10u);
+    CHECK(rope.find('z') == core::rope::npos);
+  }
+
+  SECTION("find-exhaustive") {
+    std::string text { "abaabbabababbbaaab" };
+    core::rope rope { };
+    for (std::size_t idx = 0; idx < text.size(); idx += 3) {
+      rope.append_copy(core::string_view { text }.substr(idx, 3));
+      rope.append(core::string_view { });
+    }
+    for (std::size_t first = 0; first < text.size(); ++first) {
+      for (std::size_t len = 1; len <= 5; ++len) {
+        auto needle = text.substr(first, len);
+        for (std::size_t pos = 0; pos <= text.size(); ++pos) {
+          auto expected = text.find(needle, pos);
+          auto actual = rope.find(needle, pos);
+          CHECK(actual == expected);
+        }
+      }
+    }
+  }
+
+  SECTION("equality") {
+    core::rope lhs { };
+    lhs.append("ab").append("cd");
+    core::rope rhs { };
+    rhs.append("a").append("bcd");
+    CHECK(lhs == rhs);
+    CHECK(lhs == "abcd");
+    CHECK("abcd" == lhs);
+    CHECK(lhs != "abce");
+    rhs.append("e");
+    CHECK(lhs != rhs);
+  }
+
+  SECTION("hash") {
+    std::string text(3000, 'x');
+    text[1500] = 'y';
+    core::rope lhs { };
+    lhs.append(core::string_view { text }.substr(0, 1000));
+    lhs.append_copy(core::string_view { text }.substr(1000));
+    core::rope rhs { };
+    for (std::size_t idx = 0; idx < text.size(); idx += 7) {
+      rhs.append_copy(core::string_view { text }.substr(idx, 7));
+    }
+    std::hash<core::rope> hash { };
+    CHECK(hash(lhs) == hash(rhs));
+
+    core::rope small { };
+    small.append("sm").append_copy("all");
+    std::hash<core::string_view> view_hash { };
+    CHECK(hash(small) == view_hash("small"));
+  }
+
+  SECTION("iovec") {
+    core::rope rope { };
+    rope.append("header: ").append_copy("value").append("\r\n");
+    iovec vectors[2];
+    CHECK(rope.to_iovec(vectors, 2) == 2u);
+    CHECK(vectors[0].iov_len == 8u);
+    CHECK(vectors[1].iov_len == 5u);
+    CHECK(rope.to_iovec(vectors, 2, 2) == 1u);
+    CHECK(vectors[0].iov_len == 2u);
+    CHECK(rope.to_iovec(vectors, 2, 3) == 0u);
+  }
+
+  SECTION("clear") {
+    core::rope rope { };
+    rope.append_copy("owned").append("borrowed");
+    rope.clear();
+    CHECK(rope.empty());
+    rope.append_copy("again");
+    CHECK(rope == "again");
+  }
+}
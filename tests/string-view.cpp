@@ -1,8 +1,15 @@
 #include <core/string_view.hpp>
+#include <core/algorithm.hpp>
 
 #include <unordered_map>
+#include <algorithm>
+#include <functional>
 #include <sstream>
 #include <cstring>
+#include <cstdlib>
+#include <cmath>
+#include <string>
+#include <vector>
 
 #include "catch.hpp"
 
@@ -269,6 +276,42 @@ TEST_CASE("string-view-methods", "[string-view][methods]") {
     CHECK(ref.find_last_of(pass) == 7u);
   }
 
+  SECTION("find-last-position") {
+    core::string_view ref { "abcabc" };
+    std::string const str { ref.data(), ref.size() };
+    auto npos = core::string_view::npos;
+
+    CHECK(ref.find_last_of("ab", 3) == 3u);
+    CHECK(ref.find_last_of("ab", 3) == str.find_last_of("ab", 3));
+    CHECK(ref.find_last_of("c", 2) == 2u);
+    CHECK(ref.find_last_of("c", 1) == npos);
+    CHECK(ref.find_last_of("a", 0) == 0u);
+    CHECK(ref.find_last_of("c", 100) == 5u);
+    CHECK(ref.find_last_not_of("bc", 3) == 3u);
+    CHECK(ref.find_last_not_of("bc", 3) == str.find_last_not_of("bc", 3));
+    CHECK(ref.find_last_not_of("ab", 0) == npos);
+    CHECK(ref.find_last_not_of("ab") == 5u);
+    CHECK(core::string_view { }.find_last_of("a", 0) == npos);
+  }
+
+  SECTION("find-of-sets") {
+    core::string_view line { "key = value;\tother,\xff" };
+    core::string_view delimiters { " \t,;=" };
+    auto npos = core::string_view::npos;
+
+    CHECK(line.find_first_of(delimiters) == 3u);
+    CHECK(line.find_first_of(delimiters, 4) == 4u);
+    CHECK(line.find_first_not_of(delimiters, 3) == 6u);
+    CHECK(line.find_last_of(delimiters) == 18u);
+    CHECK(line.find_last_of(delimiters, 17) == 12u);
+    CHECK(line.find_last_not_of(delimiters, 18) == 17u);
+    CHECK(line.find_first_of("\xff") == 19u);
+    CHECK(line.find_last_not_of("\xff") == 18u);
+    CHECK(line.find_first_of("") == npos);
+    CHECK(line.find_first_not_of("", 5) == 5u);
+    CHECK(line.find_first_of(delimiters, line.size()) == npos);
+  }
+
   SECTION("rfind") {
     core::string_view ref { "rfind" };
     auto npos = core::string_view::npos;
@@ -278,6 +321,15 @@ TEST_CASE("string-view-methods", "[string-view][methods]") {
 
     CHECK(ref.find("string") == npos);
     CHECK(ref.find('x') == npos);
+
+    core::string_view repeat { "abcabcabc" };
+    CHECK(repeat.rfind("abc") == 6u);
+    CHECK(repeat.rfind("abc", 5) == 3u);
+    CHECK(repeat.rfind("abc", 0) == 0u);
+    CHECK(repeat.rfind('a') == 6u);
+    CHECK(repeat.rfind('c', 1) == npos);
+    CHECK(repeat.rfind("") == repeat.size());
+    CHECK(repeat.rfind("abcabcabcd") == npos);
   }
 
   SECTION("find") {
@@ -289,6 +341,32 @@ TEST_CASE("string-view-methods", "[string-view][methods]") {
 
     CHECK(ref.find("string") == npos);
     CHECK(ref.find('x') == npos);
+
+    CHECK(ref.find("", 4) == 4u);
+    CHECK(ref.find("", 5) == npos);
+    CHECK(ref.find("d", 4) == npos);
+    CHECK(core::string_view { }.find("") == 0u);
+  }
+
+  SECTION("find-long") {
+    std::string text(1000, '-');
+    text.replace(100, 6, "needle");
+    text.replace(700, 6, "needle");
+    text.replace(998, 2, "ne");
+    core::string_view ref { text };
+    auto npos = core::string_view::npos;
+
+    CHECK(ref.find("needle") == 100u);
+    CHECK(ref.find("needle", 101) == 700u);
+    CHECK(ref.find("needle", 701) == npos);
+    CHECK(ref.find("ne", 701) == 998u);
+    CHECK(ref.find('n', 701) == 998u);
+
+    CHECK(ref.rfind("needle") == 700u);
+    CHECK(ref.rfind("needle", 699) == 100u);
+    CHECK(ref.rfind("needle", 99) == npos);
+    CHECK(ref.rfind("ne") == 998u);
+    CHECK(ref.rfind('e', 997) == 705u);
   }
 }
 
@@ -379,6 +457,127 @@ TEST_CASE("string-view-functions", "[string-view][functions]") {
     CHECK(values["fourteen"] == 14);
   }
 
+  SECTION("hash-seed") {
+    core::string_view const value { "seeded" };
+    core::string_view_hash const unseeded { };
+    core::string_view_hash const seeded { 42 };
+    CHECK(unseeded(value) == std::hash<core::string_view> { }(value));
+    CHECK(seeded(value) == core::string_view_hash { 42 }(value));
+    CHECK(seeded(value) != unseeded(value));
+
+    core::u32string_view const wide { U"\u0101\u0102" };
+    core::u32string_view const narrowed { U"\u0101" };
+    CHECK(core::u32string_view_hash { }(wide) !=
+      core::u32string_view_hash { }(narrowed));
+  }
+
+  SECTION("hash-constant") {
+    constexpr auto empty = core::string_hash("");
+    constexpr auto shorter = core::string_hash("open");
+    constexpr auto longer = core::string_hash(
+      "a key long enough to go through all three of the 48 byte lanes, "
+      "and then through the 16 byte tail loop as well"
+    );
+    constexpr auto seeded = core::string_hash("open", 7);
+    static_assert(shorter != seeded, "seed must change the hash");
+
+    core::string_view_hash const hasher { };
+    CHECK(empty == hasher(""));
+    CHECK(shorter == hasher("open"));
+    CHECK(seeded == core::string_view_hash { 7 }(core::string_view { "open" }));
+    CHECK(longer == hasher(
+      "a key long enough to go through all three of the 48 byte lanes, "
+      "and then through the 16 byte tail loop as well"
+    ));
+
+    std::string key;
+    for (auto length = 0; length < 200; ++length) {
+      key += static_cast<char>(length * 37 + 11);
+      auto const seed = static_cast<std::uint64_t>(length) * 0x9E3779B9;
+      CHECK(core::string_hash(key, seed) == core::string_view_hash { seed }(key));
+    }
+  }
+
+  SECTION("hash-murmur-high-byte") {
+    /* the eighth byte was once shifted by 54 rather than 56 bits, so its
+     * low bits landed on top of the seventh byte
+     */
+    char const lhs[8] = { 0, 0, 0, 0, 0, 0, '\x40', 0 };
+    char const rhs[8] = { 0, 0, 0, 0, 0, 0, 0, '\x01' };
+    core::impl::murmur<8> const hasher { };
+    CHECK(hasher(lhs, sizeof(lhs)) != hasher(rhs, sizeof(rhs)));
+  }
+
+  SECTION("hash-avalanche") {
+    /* flipping any input bit should flip each output bit about half the
+     * time. With 512 trials per bit, an unbiased hash stays well below 0.3
+     */
+    std::uint64_t state = 99;
+    auto next = [&state] {
+      state ^= state << 13;
+      state ^= state >> 7;
+      state ^= state << 17;
+      return state;
+    };
+    core::string_view_hash const hasher { };
+    for (std::size_t length : { 3, 8, 16, 40, 100 }) {
+      std::vector<std::uint32_t> flips(length * 8 * 64);
+      std::string key(length, '\0');
+      auto const trials = 512;
+      for (auto trial = 0; trial < trials; ++trial) {
+        for (auto& c : key) { c = static_cast<char>(next()); }
+        std::uint64_t const original = hasher(key);
+        for (std::size_t bit = 0; bit < length * 8; ++bit) {
+          key[bit / 8] ^= static_cast<char>(1 << (bit % 8));
+          std::uint64_t const changed = original ^ hasher(key);
+          key[bit / 8] ^= static_cast<char>(1 << (bit % 8));
+          for (auto out = 0; out < 64; ++out) {
+            flips[bit * 64 + out] += (changed >> out) & 1;
+          }
+        }
+      }
+      double worst = 0;
+      for (auto count : flips) {
+        auto const bias = std::abs(2.0 * count / trials - 1.0);
+        worst = std::max(worst, bias);
+      }
+      INFO("length " << length);
+      CHECK(worst < 0.3);
+    }
+  }
+
+  SECTION("hash-collisions") {
+    /* sequential keys and keys with two bits set are the classic weak
+     * spots. A collision among ~100k 64-bit hashes, or a badly skewed low
+     * byte, means trouble
+     */
+    core::string_view_hash const hasher { };
+    std::vector<std::uint64_t> hashes;
+    std::vector<std::uint32_t> buckets(256);
+    for (auto i = 0; i < 65536; ++i) {
+      hashes.push_back(hasher("key" + std::to_string(i)));
+    }
+    for (auto first = 0; first < 256; ++first) {
+      for (auto second = first + 1; second < 256; ++second) {
+        char sparse[32] = { };
+        sparse[first / 8] ^= static_cast<char>(1 << (first % 8));
+        sparse[second / 8] ^= static_cast<char>(1 << (second % 8));
+        hashes.push_back(hasher(core::string_view { sparse, sizeof(sparse) }));
+      }
+    }
+    for (auto hash : hashes) { ++buckets[hash & 0xFF]; }
+    std::sort(hashes.begin(), hashes.end());
+    auto const duplicate = std::adjacent_find(hashes.begin(), hashes.end());
+    CHECK(duplicate == hashes.end());
+
+    auto const expected = hashes.size() / 256.0;
+    double chi = 0;
+    for (auto count : buckets) {
+      chi += (count - expected) * (count - expected) / expected;
+    }
+    CHECK(chi < 400);
+  }
+
   SECTION("swap") {
     using std::swap;
     core::string_view lhs { "lhs" };
@@ -394,6 +593,324 @@ TEST_CASE("string-view-functions", "[string-view][functions]") {
   }
 }
 
+TEST_CASE("string-view-searchers", "[string-view][searchers]") {
+  SECTION("boyer-moore-horspool") {
+    core::string_view haystack { "needle in a haystack of needles" };
+    auto searcher = core::make_boyer_moore_horspool_searcher(
+      core::string_view { "needles" }
+    );
+    auto result = searcher(haystack.begin(), haystack.end());
+    CHECK(std::distance(haystack.begin(), result.first) == 24);
+    CHECK(std::distance(haystack.begin(), result.second) == 31);
+
+    auto missing = core::make_boyer_moore_horspool_searcher(
+      core::string_view { "pins" }
+    );
+    CHECK(missing(haystack.begin(), haystack.end()).first == haystack.end());
+
+    auto empty = core::make_boyer_moore_horspool_searcher(core::string_view { });
+    CHECK(empty(haystack.begin(), haystack.end()).first == haystack.begin());
+
+    core::string_view tiny { "nee" };
+    CHECK(searcher(tiny.begin(), tiny.end()).first == tiny.end());
+  }
+
+  SECTION("two-way") {
+    std::string haystack(1000, 'a');
+    haystack += "ab";
+    auto searcher = core::make_two_way_searcher(core::string_view { "aaab" });
+    auto result = searcher(haystack.begin(), haystack.end());
+    CHECK(std::distance(haystack.begin(), result.first) == 998);
+    CHECK(result.second == haystack.end());
+
+    auto periodic = core::make_two_way_searcher(
+      core::string_view { "abcabcabd" }
+    );
+    core::string_view text { "abcabcabcabcabdabc" };
+    auto match = periodic(text.begin(), text.end());
+    CHECK(std::distance(text.begin(), match.first) == 6);
+
+    auto missing = core::make_two_way_searcher(core::string_view { "aaac" });
+    CHECK(missing(haystack.begin(), haystack.end()).first == haystack.end());
+  }
+
+  SECTION("wide") {
+    core::wstring_view haystack { L"\u0101\u0201\u0101\u0301" };
+    auto bmh = core::make_boyer_moore_horspool_searcher(
+      core::wstring_view { L"\u0101\u0301" }
+    );
+    auto tw = core::make_two_way_searcher(
+      core::wstring_view { L"\u0101\u0301" }
+    );
+    auto bmh_match = bmh(haystack.begin(), haystack.end());
+    auto tw_match = tw(haystack.begin(), haystack.end());
+    CHECK(std::distance(haystack.begin(), bmh_match.first) == 2);
+    CHECK(std::distance(haystack.begin(), tw_match.first) == 2);
+  }
+
+  SECTION("randomized") {
+    std::string alphabet { "ab" };
+    std::string haystack;
+    std::uint32_t state = 12345;
+    auto next = [&state] { return (state = state * 1103515245 + 12345) >> 16; };
+    for (auto i = 0; i < 4096; ++i) { haystack += alphabet[next() % 2]; }
+    for (auto i = 0; i < 256; ++i) {
+      auto const start = next() % haystack.size();
+      auto const length = next() % 12;
+      auto const needle = haystack.substr(start, length) + alphabet[i % 2];
+      auto const expected = haystack.find(needle);
+      auto bmh = core::make_boyer_moore_horspool_searcher(
+        core::string_view { needle }
+      );
+      auto tw = core::make_two_way_searcher(core::string_view { needle });
+      auto const first = haystack.begin();
+      auto const last = haystack.end();
+      auto const bmh_result = bmh(first, last).first;
+      auto const tw_result = tw(first, last).first;
+      if (expected == std::string::npos) {
+        CHECK(bmh_result == last);
+        CHECK(tw_result == last);
+      } else {
+        CHECK(std::size_t(bmh_result - first) == expected);
+        CHECK(std::size_t(tw_result - first) == expected);
+      }
+    }
+  }
+}
+
+TEST_CASE("string-view-aho-corasick", "[string-view][aho-corasick]") {
+  using matcher_type = core::aho_corasick_matcher<char>;
+  using match = matcher_type::match;
+
+  SECTION("overlapping") {
+    matcher_type matcher { "he", "she", "his", "hers" };
+    CHECK(matcher.size() == 4u);
+    auto matches = matcher.find_all("ushers");
+    REQUIRE(matches.size() == 3u);
+    CHECK(matches[0].pattern == 1u);
+    CHECK(matches[0].position == 1u);
+    CHECK(matches[1].pattern == 0u);
+    CHECK(matches[1].position == 2u);
+    CHECK(matches[2].pattern == 3u);
+    CHECK(matches[2].position == 2u);
+    CHECK(matches[2].length == 4u);
+  }
+
+  SECTION("duplicates") {
+    std::vector<std::string> patterns { "a", "aa", "a", "" };
+    matcher_type matcher { patterns.begin(), patterns.end() };
+    CHECK(matcher.size() == 4u);
+    std::vector<std::size_t> counts(patterns.size());
+    matcher.for_each("aaa", [&counts] (match const& m) { ++counts[m.pattern]; });
+    CHECK(counts[0] == 3u);
+    CHECK(counts[1] == 2u);
+    CHECK(counts[2] == 3u);
+    CHECK(counts[3] == 0u);
+  }
+
+  SECTION("no-match") {
+    matcher_type matcher { "needle", "\xff\xfe" };
+    CHECK(matcher.find_all("haystack").empty());
+    CHECK(matcher.find_all("").empty());
+    CHECK(matcher.find_all("x\xff\xfe").size() == 1u);
+  }
+
+  SECTION("wide") {
+    core::aho_corasick_matcher<char32_t> matcher {
+      U"\u0101\u0201",
+      U"\u0201"
+    };
+    auto matches = matcher.find_all(U"\u0101\u0101\u0201\u0301");
+    REQUIRE(matches.size() == 2u);
+    CHECK(matches[0].pattern == 0u);
+    CHECK(matches[0].position == 1u);
+    CHECK(matches[1].pattern == 1u);
+    CHECK(matches[1].position == 2u);
+  }
+
+  SECTION("randomized") {
+    std::vector<std::string> patterns;
+    std::uint32_t state = 4321;
+    auto next = [&state] { return (state = state * 1103515245 + 12345) >> 16; };
+    for (auto i = 0; i < 64; ++i) {
+      std::string pattern;
+      for (auto n = 1 + next() % 5; n--;) { pattern += "abc"[next() % 3]; }
+      patterns.push_back(pattern);
+    }
+    std::string text;
+    for (auto i = 0; i < 2048; ++i) { text += "abc"[next() % 3]; }
+
+    matcher_type matcher { patterns.begin(), patterns.end() };
+    std::size_t expected = 0;
+    for (auto const& pattern : patterns) {
+      for (auto pos = text.find(pattern); pos != std::string::npos;) {
+        ++expected;
+        pos = text.find(pattern, pos + 1);
+      }
+    }
+    std::size_t found = 0;
+    std::size_t mismatched = 0;
+    matcher.for_each(text, [&] (match const& m) {
+      ++found;
+      auto const& pattern = patterns[m.pattern];
+      if (text.compare(m.position, m.length, pattern) != 0) { ++mismatched; }
+    });
+    CHECK(found == expected);
+    CHECK(mismatched == 0u);
+  }
+}
+
+TEST_CASE("string-view-string-switch", "[string-view][string-switch]") {
+  constexpr auto verbs = core::make_string_switch(
+    "get",
+    "put",
+    "post",
+    "delete",
+    core::string_view { "head", 4 },
+    "options"
+  );
+  static_assert(verbs.size() == 6, "");
+  static_assert(verbs.index("post") == 2, "");
+  static_assert(verbs.index("trace") == verbs.npos, "");
+  static_assert(verbs.index(core::string_view { "head", 4 }) == 4, "");
+
+  SECTION("lookup") {
+    CHECK(verbs(std::string { "get" }) == 0u);
+    CHECK(verbs(std::string { "put" }) == 1u);
+    CHECK(verbs(std::string { "delete" }) == 3u);
+    CHECK(verbs(std::string { "head" }) == 4u);
+    CHECK(verbs(std::string { "options" }) == 5u);
+    CHECK(verbs(std::string { "patch" }) == verbs.npos);
+    CHECK(verbs(std::string { "ge" }) == verbs.npos);
+    CHECK(verbs(std::string { }) == verbs.npos);
+    CHECK(verbs[2] == "post");
+  }
+
+  SECTION("switch") {
+    auto dispatch = [&verbs] (core::string_view verb) {
+      switch (verbs(verb)) {
+        case verbs.index("get"): return 1;
+        case verbs.index("post"): return 2;
+        case verbs.npos: return -1;
+        default: return 0;
+      }
+    };
+    CHECK(dispatch("get") == 1);
+    CHECK(dispatch("post") == 2);
+    CHECK(dispatch("options") == 0);
+    CHECK(dispatch("connect") == -1);
+  }
+
+  SECTION("many-keys") {
+    constexpr auto letters = core::make_string_switch(
+      "a", "b", "c", "d", "e", "f", "g", "h", "i", "j", "k", "l", "m",
+      "n", "o", "p", "q", "r", "s", "t", "u", "v", "w", "x", "y", "z",
+      "aa", "bb", "cc", "dd", "ee", "ff", "gg", "hh", "ii", "jj", "kk"
+    );
+    static_assert(letters.index("a") == 0, "");
+    static_assert(letters.index("z") == 25, "");
+    static_assert(letters.index("kk") == 36, "");
+    static_assert(letters.index("zz") == letters.npos, "");
+    for (std::size_t idx = 0; idx < letters.size(); ++idx) {
+      CHECK(letters(letters[idx]) == idx);
+      CHECK(letters(letters[idx].to_string() + "!") == letters.npos);
+    }
+  }
+}
+
+TEST_CASE("string-view-split", "[string-view][split]") {
+  using view = core::string_view;
+  auto collect = [] (core::range<core::split_iterator<
+    char,
+    std::char_traits<char>,
+    core::impl::char_delimiter<char, std::char_traits<char>>
+  >> tokens) {
+    return std::vector<view>(tokens.begin(), tokens.end());
+  };
+
+  SECTION("char") {
+    auto fields = collect(core::split(view { "a,,bc," }, ','));
+    REQUIRE(fields.size() == 4u);
+    CHECK(fields[0] == "a");
+    CHECK(fields[1] == "");
+    CHECK(fields[2] == "bc");
+    CHECK(fields[3] == "");
+    CHECK(collect(core::split(view { "abc" }, ',')).size() == 1u);
+    CHECK(core::split(view { }, ',').empty());
+  }
+
+  SECTION("string") {
+    auto tokens = core::split(view { "one::two::::three" }, "::");
+    CHECK(tokens.size() == 4);
+    std::vector<view> fields(tokens.begin(), tokens.end());
+    CHECK(fields[0] == "one");
+    CHECK(fields[1] == "two");
+    CHECK(fields[2] == "");
+    CHECK(fields[3] == "three");
+
+    auto letters = core::split(view { "abc" }, "");
+    std::vector<view> chars(letters.begin(), letters.end());
+    REQUIRE(chars.size() == 3u);
+    CHECK(chars[0] == "a");
+    CHECK(chars[2] == "c");
+  }
+
+  SECTION("any") {
+    auto tokens = core::split_any(view { "key = value;\tnext" }, " =;\t");
+    std::vector<view> fields;
+    for (auto token : tokens) {
+      if (not token.empty()) { fields.push_back(token); }
+    }
+    REQUIRE(fields.size() == 3u);
+    CHECK(fields[0] == "key");
+    CHECK(fields[1] == "value");
+    CHECK(fields[2] == "next");
+
+    auto wide = core::split_any(core::wstring_view { L"a.b-c" }, L".-");
+    CHECK(wide.size() == 3);
+  }
+
+  SECTION("predicate") {
+    auto tokens = core::split_if(view { "ab1cd22ef" }, [] (char c) {
+      return c >= '0' and c <= '9';
+    });
+    std::vector<view> fields(tokens.begin(), tokens.end());
+    REQUIRE(fields.size() == 4u);
+    CHECK(fields[0] == "ab");
+    CHECK(fields[1] == "cd");
+    CHECK(fields[2] == "");
+    CHECK(fields[3] == "ef");
+
+    auto copy = tokens.begin();
+    copy = tokens.end();
+    CHECK(copy == tokens.end());
+  }
+
+  SECTION("predicate-function") {
+    std::function<bool(char)> const is_space = [] (char c) { return c == ' '; };
+    auto tokens = core::split_if(view { "one two" }, is_space);
+    auto iter = tokens.begin();
+    auto other = tokens.end();
+    other = iter;
+    CHECK(*other == "one");
+    ++other;
+    CHECK(*other == "two");
+  }
+
+  SECTION("zero-copy") {
+    view const line { "alpha,beta,gamma" };
+    auto tokens = core::split(line, ',');
+    for (auto const& token : tokens) {
+      CHECK(token.data() >= line.data());
+      CHECK(token.end() <= line.end());
+    }
+    CHECK(core::count_if(tokens, [] (view token) { return token.size() > 4; }) == 2);
+    auto found = core::find(tokens, view { "beta" });
+    REQUIRE(found != tokens.end());
+    CHECK(found->data() == line.data() + 6);
+  }
+}
+
 TEST_CASE("string-view-issues", "[string-view][issues]") {
   SECTION("issue-20") {
     core::string_view const ref { "b" };
@@ -0,0 +1,27 @@
+#include <core/string.hpp>
+
+#include <string>
+
+#include "catch.hpp"
+
+TEST_CASE("string-functions", "[string][functions]") {
+  SECTION("erase") {
+    std::string str { "a-b-c-" };
+    core::erase(str, '-');
+    CHECK(str == "abc");
+    core::erase(str, 'z');
+    CHECK(str == "abc");
+  }
+
+  SECTION("erase-if") {
+    std::string str { "a1b2c3" };
+    core::erase_if(str, [] (char ch) { return ch >= '0' and ch <= '9'; });
+    CHECK(str == "abc");
+  }
+
+  SECTION("pmr-string") {
+    core::pmr::string str { "x y z" };
+    core::erase(str, ' ');
+    CHECK(str == "xyz");
+  }
+}
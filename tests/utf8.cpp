@@ -0,0 +1,100 @@
+#include <core/utf8.hpp>
+
+#include <algorithm>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "catch.hpp"
+
+TEST_CASE("utf8-validation", "[utf8]") {
+  SECTION("valid") {
+    CHECK(core::is_valid_utf8(""));
+    CHECK(core::is_valid_utf8("plain ascii"));
+    CHECK(core::is_valid_utf8("caf\xC3\xA9"));
+    CHECK(core::is_valid_utf8("\xE2\x82\xAC"));
+    CHECK(core::is_valid_utf8("\xF0\x9F\x98\x80"));
+    CHECK(core::is_valid_utf8("\xEF\xBF\xBF"));
+    CHECK(core::is_valid_utf8("\xF4\x8F\xBF\xBF"));
+  }
+
+  SECTION("invalid") {
+    CHECK_FALSE(core::is_valid_utf8("\x80"));
+    CHECK_FALSE(core::is_valid_utf8("\xC3"));
+    CHECK_FALSE(core::is_valid_utf8("\xC0\x80"));
+    CHECK_FALSE(core::is_valid_utf8("\xE0\x80\x80"));
+    CHECK_FALSE(core::is_valid_utf8("\xF0\x80\x80\x80"));
+    CHECK_FALSE(core::is_valid_utf8("\xED\xA0\x80"));
+    CHECK_FALSE(core::is_valid_utf8("\xF4\x90\x80\x80"));
+    CHECK_FALSE(core::is_valid_utf8("\xF8\x88\x80\x80\x80"));
+    CHECK_FALSE(core::is_valid_utf8("\xFF"));
+  }
+
+  SECTION("position") {
+    std::string str(100, 'a');
+    CHECK(core::find_invalid_utf8(str) == core::string_view::npos);
+    str[70] = '\xC3';
+    CHECK(core::find_invalid_utf8(str) == 70u);
+    str[71] = '\xA9';
+    CHECK(core::find_invalid_utf8(str) == core::string_view::npos);
+    str.back() = '\xE2';
+    CHECK(core::find_invalid_utf8(str) == 99u);
+  }
+
+  SECTION("block-boundaries") {
+    std::string const sequences[] = {
+      "\xC3\xA9",
+      "\xE2\x82\xAC",
+      "\xF0\x9F\x98\x80"
+    };
+    for (auto const& sequence : sequences) {
+      for (auto offset = 0u; offset < 130u; ++offset) {
+        std::string str(offset, 'x');
+        str += sequence;
+        str += std::string(offset % 7, 'y');
+        CHECK(core::is_valid_utf8(str));
+        auto truncated = str.substr(0, offset + sequence.size() - 1);
+        CHECK(core::find_invalid_utf8(truncated) == offset);
+        auto extra = str;
+        extra.insert(offset + sequence.size(), 1, '\x80');
+        CHECK(core::find_invalid_utf8(extra) == offset + sequence.size());
+      }
+    }
+  }
+}
+
+TEST_CASE("utf8-code-points", "[utf8]") {
+  SECTION("iterate") {
+    core::string_view const str { "a\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80" };
+    std::u32string decoded;
+    for (auto cp : core::code_points(str)) { decoded += cp; }
+    CHECK(decoded == U"a\u00E9\u20AC\U0001F600");
+  }
+
+  SECTION("replacement") {
+    core::string_view const str { "a\xE2\x82z\x80" };
+    std::u32string decoded;
+    for (auto cp : core::code_points(str)) { decoded += cp; }
+    CHECK(decoded == U"a\uFFFDz\uFFFD");
+  }
+
+  SECTION("base") {
+    core::string_view const str { "\xC3\xA9x" };
+    auto range = core::code_points(str);
+    auto iter = range.begin();
+    ++iter;
+    CHECK(iter.base() == str.data() + 2);
+    CHECK(*iter == U'x');
+  }
+
+  SECTION("count") {
+    CHECK(core::count_code_points("") == 0u);
+    CHECK(core::count_code_points("a\xC3\xA9\xE2\x82\xAC") == 3u);
+    std::string str;
+    for (auto i = 0; i < 1000; ++i) { str += "x\xC3\xA9\xF0\x9F\x98\x80"; }
+    CHECK(core::count_code_points(str) == 3000u);
+    auto const range = core::code_points(str);
+    auto const count = std::distance(range.begin(), range.end());
+    CHECK(count == 3000);
+  }
+}
@@ -1,13 +1,66 @@
 #include <core/variant.hpp>
 
 #include <unordered_map>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
 #include <cstdint>
+#include <cstring>
 
 #include "catch.hpp"
 
+namespace {
+
+struct sizer final {
+  std::size_t operator ()(std::string const& str) const { return str.size(); }
+  std::size_t operator ()(std::vector<int> const& vec) const {
+    return vec.size();
+  }
+  template <class T>
+  std::size_t operator ()(T const&) const { return sizeof(T); }
+};
+
+/* construction fails for negative values, and every move throws */
+struct throwing_move final {
+  explicit throwing_move (int value) : value { value } {
+    if (value < 0) { throw std::invalid_argument { "negative" }; }
+  }
+
+  throwing_move (throwing_move&&) : value { 0 } {
+    throw std::runtime_error { "move" };
+  }
+
+  throwing_move& operator = (throwing_move&&) {
+    throw std::runtime_error { "move" };
+  }
+
+  int value;
+};
+
+/* copyable but not assignable, and moving a negative value throws. Live
+ * objects are counted so that a double destruction shows up.
+ */
+struct fragile final {
+  static int live;
+
+  explicit fragile (int value) : value { value } { ++live; }
+  fragile (fragile const& that) : value { that.value } { ++live; }
+  fragile (fragile&& that) : value { that.value } {
+    if (that.value < 0) { throw std::runtime_error { "move" }; }
+    ++live;
+  }
+  ~fragile () { --live; }
+
+  fragile& operator = (fragile const&) = delete;
+
+  int value;
+};
+
+int fragile::live = 0;
+
+} /* nameless namespace */
+
 TEST_CASE("variant-constructors", "[variant][constructors]") {
   SECTION("default") {
     core::variant<std::string, int> variant { };
@@ -47,6 +100,50 @@ TEST_CASE("variant-constructors", "[variant][constructors]") {
   }
 }
 
+TEST_CASE("variant-traits", "[variant][traits]") {
+  SECTION("trivially-copyable") {
+    using trivial = core::variant<int, double, char>;
+    using nontrivial = core::variant<int, std::string>;
+
+    static_assert(std::is_trivially_copyable<trivial>::value, "");
+    static_assert(std::is_trivially_destructible<trivial>::value, "");
+    static_assert(std::is_trivially_copy_constructible<trivial>::value, "");
+    static_assert(std::is_trivially_move_constructible<trivial>::value, "");
+    static_assert(std::is_trivially_copy_assignable<trivial>::value, "");
+    static_assert(std::is_trivially_move_assignable<trivial>::value, "");
+
+    static_assert(not std::is_trivially_copyable<nontrivial>::value, "");
+    static_assert(not std::is_trivially_destructible<nontrivial>::value, "");
+    static_assert(std::is_nothrow_move_constructible<nontrivial>::value, "");
+    static_assert(std::is_copy_constructible<nontrivial>::value, "");
+    static_assert(std::is_copy_assignable<nontrivial>::value, "");
+  }
+
+  SECTION("memcpy") {
+    using variant_type = core::variant<int, double, char>;
+    variant_type source { 4.5 };
+    variant_type target { };
+
+    std::memcpy(&target, &source, sizeof(variant_type));
+
+    CHECK(target.index() == 1u);
+    CHECK(core::get<1>(target) == 4.5);
+    CHECK(target == source);
+  }
+
+  SECTION("vector-copy") {
+    using variant_type = core::variant<int, double, char>;
+    std::vector<variant_type> source { 1, 2.0, 'c' };
+    auto copy = source;
+
+    CHECK(copy.size() == 3u);
+    CHECK(copy[0].index() == 0u);
+    CHECK(copy[1].index() == 1u);
+    CHECK(copy[2].index() == 2u);
+    CHECK(copy == source);
+  }
+}
+
 TEST_CASE("variant-assignment", "[variant][assignment]") {
   SECTION("value") {
     using variant_type = core::variant<std::string, double>;
@@ -90,6 +187,38 @@ TEST_CASE("variant-assignment", "[variant][assignment]") {
     CHECK(core::get<1>(copy) == 9.8);
     CHECK(copy == variant);
   }
+
+  SECTION("same-alternative") {
+    using variant_type = core::variant<std::string, double>;
+    variant_type variant { std::string(64, 'x') };
+    variant_type other { std::string { "short" } };
+    auto const data = core::get<0>(variant).data();
+
+    variant = other;
+    CHECK(core::get<0>(variant) == "short");
+    CHECK(core::get<0>(variant).data() == data);
+
+    variant = std::string { "value" };
+    CHECK(core::get<0>(variant) == "value");
+    CHECK(core::get<0>(variant).data() == data);
+
+    variant = 4.2;
+    CHECK(variant.index() == 1u);
+    CHECK(core::get<1>(variant) == 4.2);
+  }
+
+  SECTION("non-assignable") {
+    struct constant { int const value; };
+    using variant_type = core::variant<constant, double>;
+    variant_type variant { constant { 1 } };
+    variant_type other { constant { 2 } };
+
+    variant = other;
+    CHECK(core::get<0>(variant).value == 2);
+
+    variant = std::move(other);
+    CHECK(core::get<0>(variant).value == 2);
+  }
 }
 
 TEST_CASE("variant-methods", "[variant][methods]") {
@@ -153,6 +282,94 @@ TEST_CASE("variant-methods", "[variant][methods]") {
     );
   }
 
+  SECTION("visit-table") {
+    using variant_type = core::variant<
+      char, short, int, long, float, double,
+      std::string, std::vector<int>, std::uint8_t, std::uint64_t
+    >;
+    variant_type const string { std::string { "table" } };
+    variant_type const vector { std::vector<int> { 1, 2 } };
+    variant_type integer { std::uint64_t { 8 } };
+
+    CHECK(string.visit(sizer { }) == 5u);
+    CHECK(vector.visit(sizer { }) == 2u);
+    CHECK(integer.visit(sizer { }) == sizeof(std::uint64_t));
+    CHECK(
+      integer.match(
+        [](std::uint64_t& value) { return value == 8u; },
+        [](std::string&) { return false; },
+        [](std::vector<int>&) { return false; },
+        [](char&) { return false; },
+        [](short&) { return false; },
+        [](int&) { return false; },
+        [](long&) { return false; },
+        [](float&) { return false; },
+        [](double&) { return false; },
+        [](std::uint8_t&) { return false; }
+      )
+    );
+  }
+
+  SECTION("visit-arguments") {
+    using variant_type = core::variant<int, double>;
+    variant_type integer { 4 };
+    variant_type const real { 2.5 };
+    auto multiply = [](double value, double by) { return value * by; };
+
+    CHECK(integer.visit(multiply, 2.0) == 8.0);
+    CHECK(real.visit(multiply, 2.0) == 5.0);
+  }
+
+  SECTION("emplace") {
+    using variant_type = core::variant<std::string, std::vector<int>, int>;
+    variant_type variant { };
+
+    auto& vector = variant.emplace<1>(3u, 7);
+    CHECK(variant.index() == 1u);
+    CHECK(vector.size() == 3u);
+    CHECK(core::get<1>(variant)[2] == 7);
+
+    auto& string = variant.emplace<std::string>(4u, 'a');
+    CHECK(variant.index() == 0u);
+    CHECK(string == "aaaa");
+
+    variant.emplace<int>(5);
+    CHECK(core::get<2>(variant) == 5);
+  }
+
+  SECTION("emplace-throwing-move") {
+    using variant_type = core::variant<int, throwing_move>;
+    variant_type variant { 7 };
+    CHECK_THROWS_AS(variant.emplace<1>(-1), std::invalid_argument const&);
+    CHECK(core::get<0>(variant) == 7);
+
+    variant_type held { core::emplace_index_t<1> { }, 3 };
+    CHECK_THROWS_AS(held.emplace<1>(4), std::runtime_error const&);
+    CHECK(core::get<1>(held).value == 3);
+
+    variant_type other { 9 };
+    CHECK_THROWS_AS(other.emplace<1>(5), std::runtime_error const&);
+    REQUIRE(other.index() == 0u);
+    CHECK(core::get<0>(other) == 9);
+  }
+
+  SECTION("assign-throwing-move") {
+    using variant_type = core::variant<fragile, int>;
+    {
+      variant_type target { core::emplace_index_t<0> { }, 1 };
+      variant_type source { core::emplace_index_t<0> { }, -1 };
+      CHECK_THROWS_AS(target = source, std::runtime_error const&);
+      REQUIRE(target.index() == 0u);
+      CHECK(core::get<0>(target).value == 1);
+
+      variant_type number { 4 };
+      CHECK_THROWS_AS(number = std::move(source), std::runtime_error const&);
+      REQUIRE(number.index() == 1u);
+      CHECK(core::get<1>(number) == 4);
+    }
+    CHECK(fragile::live == 0);
+  }
+
   SECTION("index") {
     using variant_type = core::variant<
       std::uint64_t,
@@ -337,3 +554,113 @@ TEST_CASE("variant-issues", "[variant][issues]") {
     CHECK(variant.index() == 1u);
   }
 }
+
+TEST_CASE("variant-vector", "[variant-vector]") {
+  using vector_type = core::variant_vector<int, std::string, double>;
+
+  SECTION("push-back") {
+    using variant_type = vector_type::value_type;
+    vector_type vector { };
+    variant_type const string { std::string { "push" } };
+
+    vector.push_back(variant_type { 1 });
+    vector.push_back(string);
+    vector.push_back(variant_type { 2.5 });
+    vector.push_back(variant_type { 3 });
+
+    CHECK(vector.size() == 4u);
+    CHECK(vector.index(0) == 0u);
+    CHECK(vector.index(1) == 1u);
+    CHECK(vector.index(2) == 2u);
+    CHECK(vector.index(3) == 0u);
+    CHECK(vector[1] == string);
+    CHECK(vector[3] == variant_type { 3 });
+    CHECK(vector.alternative<0>().size() == 2u);
+    CHECK(vector.alternative<1>().size() == 1u);
+  }
+
+  SECTION("emplace-back") {
+    vector_type vector { };
+    vector.emplace_back<1>(3u, 'a');
+    vector.emplace_back<int>(7);
+    vector.emplace_back<double>(0.5);
+
+    CHECK(vector.size() == 3u);
+    CHECK(*vector.get<1>(0) == "aaa");
+    CHECK(*vector.get<0>(1) == 7);
+    CHECK(*vector.get<2>(2) == 0.5);
+    CHECK_FALSE(vector.get<0>(0));
+  }
+
+  SECTION("pop-back") {
+    vector_type vector { };
+    vector.emplace_back<0>(1);
+    vector.emplace_back<1>("pop");
+    vector.emplace_back<0>(2);
+    vector.pop_back();
+
+    CHECK(vector.size() == 2u);
+    CHECK(vector.alternative<0>().size() == 1u);
+    CHECK(vector.alternative<0>().front() == 1);
+
+    vector.clear();
+    CHECK(vector.empty());
+    CHECK(vector.alternative<1>().empty());
+  }
+
+  SECTION("visit") {
+    vector_type vector { };
+    vector.emplace_back<0>(4);
+    vector.emplace_back<1>("visit");
+    vector.emplace_back<2>(1.5);
+
+    CHECK(vector.visit(1, sizer { }) == 5u);
+    CHECK(vector.visit(0, sizer { }) == sizeof(int));
+
+    auto doubled = 0.0;
+    for (std::size_t idx = 0; idx < vector.size(); ++idx) {
+      vector.match(idx,
+        [&doubled](double value) { doubled += value * 2; },
+        [&doubled](int value) { doubled += value * 2; },
+        [](std::string const&) { });
+    }
+    CHECK(doubled == 11.0);
+  }
+
+  SECTION("for-each") {
+    vector_type vector { };
+    for (int idx = 0; idx < 100; ++idx) {
+      if (idx % 10 == 0) { vector.emplace_back<1>(std::to_string(idx)); }
+      else { vector.emplace_back<0>(idx); }
+    }
+
+    auto total = 0;
+    vector.for_each<0>([&total](int& value) { total += value; });
+    CHECK(total == 4500);
+    CHECK(vector.alternative<1>().size() == 10u);
+    CHECK(vector.size() == 100u);
+    CHECK(vector[90] == vector_type::value_type { std::string { "90" } });
+  }
+  SECTION("bool-alternative") {
+    using bool_vector = core::variant_vector<bool, int>;
+    using variant_type = bool_vector::value_type;
+    bool_vector vector { };
+    vector.push_back(variant_type { true });
+    vector.emplace_back<1>(4);
+    vector.emplace_back<0>(false);
+
+    auto const engaged = vector.get<0>(0);
+    REQUIRE(engaged);
+    CHECK(*engaged);
+    *engaged = false;
+    CHECK_FALSE(*vector.get<0>(0));
+    CHECK_FALSE(vector.get<0>(1));
+    CHECK(vector[1] == variant_type { 4 });
+
+    auto count = 0;
+    vector.for_each<0>([&count](bool& value) { count += not value; });
+    CHECK(count == 2);
+    CHECK(vector.alternative<0>().size() == 2u);
+    CHECK(sizeof(vector.alternative<0>().front()) == sizeof(bool));
+  }
+}